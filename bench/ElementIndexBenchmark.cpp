@@ -0,0 +1,86 @@
+#include "ElementIndexBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/lib/runtime/TixiHelper.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // best time of func in ms
+    template <typename Func>
+    auto measure(unsigned int iterations, Func func) -> double {
+        auto best = std::numeric_limits<double>::max();
+        for (unsigned int i = 0; i < iterations; i++) {
+            const auto start = Clock::now();
+            func();
+            best = std::min(best, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        }
+        return best;
+    }
+
+    // canonical paths of all elements below root, e.g. /cpacs[1]/header[1]
+    auto elementPaths(const TixiDocumentHandle& tixiHandle, const std::string& root) -> std::vector<std::string> {
+        std::vector<std::string> paths;
+        std::vector<std::string> pending(1, root + "[1]");
+        while (!pending.empty()) {
+            auto path = std::move(pending.back());
+            pending.pop_back();
+            std::vector<std::pair<std::string, int>> childCounts;
+            const auto count = tixi::TixiGetNumberOfChilds(tixiHandle, path);
+            for (int i = 1; i <= count; i++) {
+                const auto name = tixi::TixiGetChildNodeName(tixiHandle, path, i);
+                if (name.empty() || name[0] == '#')
+                    continue;
+                const auto it = std::find_if(childCounts.begin(), childCounts.end(), [&](const std::pair<std::string, int>& c) { return c.first == name; });
+                if (it != childCounts.end())
+                    it->second++;
+                else
+                    childCounts.emplace_back(name, 1);
+            }
+            for (const auto& c : childCounts)
+                for (int i = 1; i <= c.second; i++)
+                    pending.push_back(path + "/" + c.first + "[" + std::to_string(i) + "]");
+            paths.push_back(std::move(path));
+        }
+        return paths;
+    }
+}
+
+void runElementIndexBenchmarks(const std::string& documentFile, const std::string& rootXPath, unsigned int iterations) {
+    TixiDocumentHandle tixiHandle = -1;
+    if (tixiOpenDocument(documentFile.c_str(), &tixiHandle) != SUCCESS)
+        throw std::runtime_error("Failed to open " + documentFile);
+
+    const auto paths = elementPaths(tixiHandle, rootXPath);
+    std::size_t found = 0;
+
+    const auto build = measure(iterations, [&] {
+        tixi::TixiEnableElementIndex(tixiHandle, rootXPath);
+    });
+    const auto indexed = measure(iterations, [&] {
+        for (const auto& p : paths)
+            found += tixi::TixiCheckElementIndexed(tixiHandle, p);
+    });
+    tixi::TixiDisableElementIndex(tixiHandle);
+    const auto unindexed = measure(iterations, [&] {
+        for (const auto& p : paths)
+            found += tixi::TixiCheckElement(tixiHandle, p);
+    });
+    tixi::TixiCloseDocumentIndexed(tixiHandle);
+    if (found != 2 * iterations * paths.size())
+        throw std::logic_error("Not all elements were found");
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Element index of " << paths.size() << " elements below " << rootXPath << " in " << documentFile << ", best of " << iterations << " iterations" << std::endl;
+    std::cout << "\tBuild                    " << std::setw(10) << build     << " ms" << std::endl;
+    std::cout << "\tCheck all with index     " << std::setw(10) << indexed   << " ms" << std::endl;
+    std::cout << "\tCheck all without index  " << std::setw(10) << unindexed << " ms" << std::endl;
+}
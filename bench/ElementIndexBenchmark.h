@@ -0,0 +1,6 @@
+#pragma once
+
+#include <string>
+
+// measures building the element index of a document, e.g. a CPACS aircraft file, and checking for each of its elements with and without it
+void runElementIndexBenchmarks(const std::string& documentFile, const std::string& rootXPath, unsigned int iterations);
@@ -0,0 +1,211 @@
+#include "GeneratorBenchmark.h"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "../src/lib/CodeGen.h"
+#include "../src/lib/Filesystem.h"
+#include "../src/lib/Logging.h"
+#include "../src/lib/Profiler.h"
+#include "../src/lib/SchemaParser.h"
+#include "../src/lib/Tables.h"
+#include "../src/lib/TypeSystem.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+    const auto tableFiles = {
+        "CustomTypes.txt",
+        "TypeSubstitution.txt",
+        "PruneList.txt",
+        "ParentPointer.txt",
+    };
+
+    void writeChoice(std::ostream& xsd, std::size_t level, std::size_t nesting) {
+        xsd << "\t\t\t<xsd:choice>\n";
+        xsd << "\t\t\t\t<xsd:element name=\"optA" << level << "\" type=\"xsd:double\"/>\n";
+        xsd << "\t\t\t\t<xsd:sequence>\n";
+        xsd << "\t\t\t\t\t<xsd:element name=\"optB" << level << "\" type=\"xsd:int\"/>\n";
+        if (level + 1 < nesting)
+            writeChoice(xsd, level + 1, nesting);
+        xsd << "\t\t\t\t</xsd:sequence>\n";
+        xsd << "\t\t\t</xsd:choice>\n";
+    }
+
+    // Types form trees of the given depth and fanout, filled depth first and hung below the root type.
+    // Half of the types derive from a base class chain, every type refers to an enum and contains nested choices
+    void writeSyntheticSchema(const fs::path& file, std::size_t typeCount, const SyntheticSchemaOptions& options) {
+        const auto enumCount = options.enums > 0 ? options.enums : std::max<std::size_t>(1, typeCount / 10);
+        const auto chainCount = options.inheritance > 0 ? std::max<std::size_t>(1, typeCount / 64) : 0;
+        const auto depth = std::max<std::size_t>(1, options.depth);
+        const auto fanout = std::max<std::size_t>(1, options.fanout);
+
+        struct Node {
+            std::size_t type;
+            std::size_t level;
+            std::size_t children;
+        };
+        std::vector<std::vector<std::size_t>> children(typeCount);
+        std::vector<Node> stack{ Node{ 0, 0, 0 } };
+        for (std::size_t t = 1; t < typeCount; t++) {
+            // the root is never full
+            while (stack.back().level >= depth || (stack.back().type != 0 && stack.back().children >= fanout))
+                stack.pop_back();
+            auto& parent = stack.back();
+            children[parent.type].push_back(t);
+            parent.children++;
+            const auto level = parent.level + 1;
+            stack.push_back(Node{ t, level, 0 });
+        }
+
+        std::ofstream xsd(file.string());
+        if (!xsd)
+            throw std::runtime_error("Failed to open file " + file.string() + " for writing");
+        xsd << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+        xsd << "<xsd:schema xmlns:xsd=\"http://www.w3.org/2001/XMLSchema\">\n";
+        xsd << "\t<xsd:element name=\"root\" type=\"T0Type\"/>\n";
+
+        for (std::size_t e = 0; e < enumCount; e++) {
+            // few distinct value sets, so many enums are collapsed
+            xsd << "\t<xsd:simpleType name=\"E" << e << "Type\">\n";
+            xsd << "\t\t<xsd:restriction base=\"xsd:string\">\n";
+            for (std::size_t v = 0; v < 3 + e % 5; v++)
+                xsd << "\t\t\t<xsd:enumeration value=\"value" << v << "\"/>\n";
+            xsd << "\t\t</xsd:restriction>\n";
+            xsd << "\t</xsd:simpleType>\n";
+        }
+
+        for (std::size_t c = 0; c < chainCount; c++) {
+            for (std::size_t l = 0; l < options.inheritance; l++) {
+                xsd << "\t<xsd:complexType name=\"B" << c << "L" << l << "Type\">\n";
+                if (l > 0)
+                    xsd << "\t\t<xsd:complexContent>\n\t\t<xsd:extension base=\"B" << c << "L" << l - 1 << "Type\">\n";
+                xsd << "\t\t<xsd:sequence>\n";
+                xsd << "\t\t\t<xsd:element name=\"base" << l << "\" type=\"xsd:string\" minOccurs=\"0\"/>\n";
+                xsd << "\t\t</xsd:sequence>\n";
+                if (l > 0)
+                    xsd << "\t\t</xsd:extension>\n\t\t</xsd:complexContent>\n";
+                xsd << "\t</xsd:complexType>\n";
+            }
+        }
+
+        for (std::size_t t = 0; t < typeCount; t++) {
+            const auto derived = chainCount > 0 && t > 0 && t % 2 == 0;
+            xsd << "\t<xsd:complexType name=\"T" << t << "Type\">\n";
+            if (derived)
+                xsd << "\t\t<xsd:complexContent>\n\t\t<xsd:extension base=\"B" << t % chainCount << "L" << options.inheritance - 1 << "Type\">\n";
+            xsd << "\t\t<xsd:sequence>\n";
+            xsd << "\t\t\t<xsd:element name=\"name\" type=\"xsd:string\"/>\n";
+            for (const auto c : children[t])
+                xsd << "\t\t\t<xsd:element name=\"c" << c << "\" type=\"T" << c << "Type\" minOccurs=\"0\"" << (c % 2 ? " maxOccurs=\"unbounded\"" : "") << "/>\n";
+            if (options.choiceNesting > 0)
+                writeChoice(xsd, 0, options.choiceNesting);
+            xsd << "\t\t</xsd:sequence>\n";
+            if (t % 2 == 1)
+                xsd << "\t\t<xsd:attribute name=\"uID\" type=\"xsd:string\" use=\"required\"/>\n";
+            xsd << "\t\t<xsd:attribute name=\"kind\" type=\"E" << t % enumCount << "Type\" use=\"optional\"/>\n";
+            if (derived)
+                xsd << "\t\t</xsd:extension>\n\t\t</xsd:complexContent>\n";
+            xsd << "\t</xsd:complexType>\n";
+        }
+
+        xsd << "</xsd:schema>\n";
+    }
+
+    void writeRun(std::ostream& os, std::size_t typeCount, std::size_t classes, std::size_t enums, std::size_t files, std::vector<tigl::PhaseRecord> records) {
+        std::sort(std::begin(records), std::end(records), [](const tigl::PhaseRecord& a, const tigl::PhaseRecord& b) {
+            return a.startSeconds < b.startSeconds;
+        });
+
+        os << "    { \"types\": " << typeCount << ", \"classes\": " << classes << ", \"enums\": " << enums << ", \"files\": " << files << ", \"phases\": [";
+        for (std::size_t i = 0; i < records.size(); i++) {
+            const auto& r = records[i];
+            os << (i == 0 ? "\n" : ",\n")
+                << "      { \"name\": \"" << r.name << "\", \"depth\": " << r.depth << ", \"wall\": " << r.wallSeconds << ", \"cpu\": " << r.cpuSeconds
+                << ", \"peakRss\": " << r.peakRss << ", \"allocations\": " << r.allocations << " }";
+        }
+        os << "\n    ] }";
+    }
+}
+
+void runGeneratorBenchmarks(const SyntheticSchemaOptions& options, const std::atomic<std::uint64_t>* allocations) {
+    auto& profiler = tigl::Profiler::instance();
+    profiler.enable(allocations);
+
+    // the generator's progress messages would mix with the results on stdout
+    tigl::Logger::instance().setConsoleLevel(tigl::LogLevel::Warning);
+
+    std::cout << std::fixed << std::setprecision(6);
+    std::cout << "{\n";
+    std::cout << "  \"fanout\": " << options.fanout << ", \"depth\": " << options.depth << ", \"enums\": " << options.enums
+        << ", \"choiceNesting\": " << options.choiceNesting << ", \"inheritance\": " << options.inheritance << ", \"jobs\": " << options.jobs << ",\n";
+    std::cout << "  \"runs\": [";
+
+    for (std::size_t i = 0; i < options.typeCounts.size(); i++) {
+        const auto typeCount = std::max<std::size_t>(1, options.typeCounts[i]);
+        const auto pass = "run" + std::to_string(i);
+        std::cerr << "Generating " << typeCount << " types" << std::endl;
+
+        const auto dir = fs::temp_directory_path() / fs::unique_path();
+        const auto inputDir = dir / "input";
+        const auto outputDir = dir / "output";
+        fs::create_directories(inputDir);
+        fs::create_directories(outputDir);
+        for (const auto& table : tableFiles)
+            std::ofstream((inputDir / table).string());
+        writeSyntheticSchema(inputDir / "schema.xsd", typeCount, options);
+
+        std::size_t classes = 0;
+        std::size_t enums = 0;
+        std::size_t files = 0;
+        try {
+            const tigl::Tables tables(inputDir.string());
+
+            tigl::xsd::SchemaTypes types;
+            {
+                tigl::ProfilePhase phase("parseSchema", pass);
+                types = tigl::xsd::parseSchema((inputDir / "schema.xsd").string());
+            }
+
+            tigl::TypeSystem typeSystem;
+            {
+                tigl::ProfilePhase phase("buildTypeSystem", pass);
+                typeSystem = tigl::buildTypeSystem(std::move(types), tables);
+            }
+            classes = std::count_if(std::begin(typeSystem.classes), std::end(typeSystem.classes), [](const tigl::Class& c) { return !c.pruned; });
+            enums = std::count_if(std::begin(typeSystem.enums), std::end(typeSystem.enums), [](const tigl::Enum& e) { return !e.pruned; });
+
+            tigl::Filesystem output;
+            {
+                tigl::ProfilePhase phase("genCode", pass);
+                tigl::genCode(outputDir.string(), typeSystem, "", tables, output, options.jobs);
+            }
+            {
+                tigl::ProfilePhase phase("flushToDisk", pass);
+                output.flushToDisk(options.jobs);
+            }
+            files = output.newlywritten;
+        } catch (...) {
+            fs::remove_all(dir);
+            throw;
+        }
+        fs::remove_all(dir);
+
+        std::vector<tigl::PhaseRecord> records;
+        for (const auto& r : profiler.records())
+            if (r.pass == pass)
+                records.push_back(r);
+
+        std::cout << (i == 0 ? "\n" : ",\n");
+        writeRun(std::cout, typeCount, classes, enums, files, std::move(records));
+    }
+
+    std::cout << "\n  ]\n";
+    std::cout << "}" << std::endl;
+}
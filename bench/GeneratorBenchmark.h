@@ -0,0 +1,21 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// shape of the synthetic schemas generated for the generator benchmark
+struct SyntheticSchemaOptions {
+    std::vector<std::size_t> typeCounts = { 1000, 10000, 100000 }; // one run per count
+    std::size_t fanout = 4;       // child elements per type, except the root which collects all trees
+    std::size_t depth = 8;        // maximum nesting of types below the root
+    std::size_t enums = 0;        // 0 creates one enum per 10 types
+    std::size_t choiceNesting = 2;
+    std::size_t inheritance = 3;  // length of the base class chains, one chain per 64 types
+    unsigned int jobs = 1;
+};
+
+// runs parseSchema, buildTypeSystem, genCode and flushToDisk on synthetic schemas and writes the phase timings as JSON to stdout.
+// allocations is the counter incremented by the benchmark's operator new
+void runGeneratorBenchmarks(const SyntheticSchemaOptions& options, const std::atomic<std::uint64_t>* allocations);
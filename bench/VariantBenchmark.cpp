@@ -0,0 +1,169 @@
+#include "VariantBenchmark.h"
+
+#include <boost/optional.hpp>
+#include <boost/variant.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "../src/lib/SchemaParser.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // the previous implementation of tigl::Variant, as reference
+    template <typename... Ts>
+    class BoostVariant {
+    public:
+        BoostVariant() {}
+
+        template<typename T>
+        BoostVariant(const T& t) {
+            m_data = t;
+        }
+
+        template<typename Visitor>
+        void visit(Visitor func) const {
+            if (m_data) {
+                VisitorWrapper<Visitor> visitor(func);
+                m_data->apply_visitor(visitor);
+            }
+        }
+
+        template<typename T>
+        bool is() const {
+            if (m_data)
+                return m_data->type() == typeid(T);
+            return false;
+        }
+
+        template<typename T>
+        const T& as() const {
+            return boost::get<const T&>(*m_data);
+        }
+
+    private:
+        template <typename Func>
+        struct VisitorWrapper : public boost::static_visitor<> {
+            VisitorWrapper(Func func)
+                : m_func(func) {}
+
+            template<typename T>
+            void operator()(T&& arg) {
+                m_func(std::forward<T>(arg));
+            }
+
+        private:
+            Func m_func;
+        };
+
+        boost::optional<boost::variant<Ts...>> m_data;
+    };
+
+    struct CountingVisitor {
+        void operator()(const tigl::xsd::Element& e) { counts[0] += e.minOccurs; }
+        void operator()(const tigl::xsd::Group&)     { counts[1]++; }
+        void operator()(const tigl::xsd::Choice& c)  { counts[2] += c.minOccurs; }
+        void operator()(const tigl::xsd::Sequence&)  { counts[3]++; }
+        void operator()(const tigl::xsd::Any&)       { counts[4]++; }
+
+        std::size_t* counts;
+    };
+
+    // the content of sequences and choices, a random mix of all alternatives
+    template <template <typename...> class V>
+    auto makeContent(std::size_t count) -> std::vector<V<tigl::xsd::Element, tigl::xsd::Group, tigl::xsd::Choice, tigl::xsd::Sequence, tigl::xsd::Any>> {
+        std::mt19937 rng(42);
+        std::vector<V<tigl::xsd::Element, tigl::xsd::Group, tigl::xsd::Choice, tigl::xsd::Sequence, tigl::xsd::Any>> content;
+        content.reserve(count);
+        for (std::size_t i = 0; i < count; i++) {
+            switch (rng() % 8) {
+                case 0: { tigl::xsd::Choice c; c.minOccurs = 1; content.push_back(c); break; }
+                case 1: content.push_back(tigl::xsd::Sequence()); break;
+                case 2: content.push_back(tigl::xsd::Any()); break;
+                case 3: content.push_back(tigl::xsd::Group()); break;
+                default: {
+                    tigl::xsd::Element e;
+                    e.minOccurs = static_cast<unsigned int>(i % 2);
+                    e.maxOccurs = 1;
+                    content.push_back(e);
+                    break;
+                }
+            }
+        }
+        return content;
+    }
+
+    // nanoseconds per item of the fastest of the given iterations
+    template <typename Func>
+    auto measure(unsigned int iterations, std::size_t items, Func func) -> double {
+        auto best = std::numeric_limits<double>::max();
+        for (unsigned int i = 0; i < iterations; i++) {
+            const auto start = Clock::now();
+            func();
+            best = std::min(best, std::chrono::duration<double, std::nano>(Clock::now() - start).count() / items);
+        }
+        return best;
+    }
+
+    struct Timings {
+        double is;
+        double as;
+        double visit;
+        double copy;
+    };
+
+    template <template <typename...> class V>
+    auto run(std::size_t count, unsigned int iterations, std::size_t& checksum) -> Timings {
+        const auto content = makeContent<V>(count);
+
+        Timings t;
+        t.is = measure(iterations, count, [&] {
+            for (const auto& v : content)
+                checksum += v.template is<tigl::xsd::Element>();
+        });
+        t.as = measure(iterations, count, [&] {
+            for (const auto& v : content)
+                if (v.template is<tigl::xsd::Element>())
+                    checksum += v.template as<tigl::xsd::Element>().minOccurs;
+        });
+        t.visit = measure(iterations, count, [&] {
+            std::size_t counts[5] = {};
+            for (const auto& v : content)
+                v.visit(CountingVisitor{ counts });
+            checksum += counts[0] + counts[1] + counts[2] + counts[3] + counts[4];
+        });
+        t.copy = measure(iterations, count, [&] {
+            const auto copy = content;
+            checksum += copy.size();
+        });
+        return t;
+    }
+}
+
+void runVariantBenchmarks(unsigned int iterations) {
+    const std::size_t count = 1000000;
+    std::size_t boostChecksum = 0;
+    std::size_t tiglChecksum = 0;
+    const auto boost = run<BoostVariant>(count, iterations, boostChecksum);
+    const auto tigl = run<tigl::Variant>(count, iterations, tiglChecksum);
+    if (boostChecksum != tiglChecksum)
+        throw std::logic_error("Variant implementations computed different results");
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Variant operations on " << count << " sequence contents, " << iterations << " iterations, ns per item" << std::endl;
+    std::cout << "\t        " << std::setw(10) << "boost" << std::setw(10) << "tigl" << std::setw(10) << "speedup" << std::endl;
+    auto print = [](const char* name, double b, double t) {
+        std::cout << "\t" << std::left << std::setw(8) << name << std::right << std::setw(10) << b << std::setw(10) << t << std::setw(9) << b / t << "x" << std::endl;
+    };
+    print("is",    boost.is,    tigl.is);
+    print("as",    boost.as,    tigl.as);
+    print("visit", boost.visit, tigl.visit);
+    print("copy",  boost.copy,  tigl.copy);
+}
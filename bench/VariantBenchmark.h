@@ -0,0 +1,4 @@
+#pragma once
+
+// compares tigl::Variant against the previous boost::optional<boost::variant> based implementation
+void runVariantBenchmarks(unsigned int iterations);
@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/driver/AllocationCounter.h"
+#include "../src/lib/SchemaParser.h"
+#include "ElementIndexBenchmark.h"
+#include "GeneratorBenchmark.h"
+#include "VariantBenchmark.h"
+
+namespace {
+    // parses the options of --generator, returns false on invalid options
+    auto parseGeneratorOptions(int argc, char* argv[], SyntheticSchemaOptions& options) -> bool {
+        try {
+            for (int i = 2; i < argc; i += 2) {
+                const std::string arg = argv[i];
+                if (i + 1 >= argc)
+                    return false;
+                const std::string value = argv[i + 1];
+                if (arg == "--types") {
+                    options.typeCounts.clear();
+                    std::istringstream ss(value);
+                    std::string count;
+                    while (std::getline(ss, count, ','))
+                        options.typeCounts.push_back(std::stoul(count));
+                } else if (arg == "--fanout")
+                    options.fanout = std::stoul(value);
+                else if (arg == "--depth")
+                    options.depth = std::stoul(value);
+                else if (arg == "--enums")
+                    options.enums = std::stoul(value);
+                else if (arg == "--choices")
+                    options.choiceNesting = std::stoul(value);
+                else if (arg == "--inheritance")
+                    options.inheritance = std::stoul(value);
+                else if (arg == "--jobs")
+                    options.jobs = static_cast<unsigned int>(std::stoul(value));
+                else
+                    return false;
+            }
+            return true;
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Result {
+        double min = 0;
+        double mean = 0;
+        std::size_t types = 0;
+        std::size_t allocations = 0; // per parse
+        std::size_t retained = 0;    // allocations still held by the parsed schema
+    };
+
+    auto measure(const std::string& schemaFile, tigl::xsd::ParserBackend backend, unsigned int iterations) -> Result {
+        Result r;
+        std::vector<double> times;
+        std::size_t types = 0;
+        for (unsigned int i = 0; i < iterations; i++) {
+            const auto allocationsBefore = tigl::AllocationCounter::allocations().load();
+            const auto deallocationsBefore = tigl::AllocationCounter::deallocations().load();
+            const auto start = Clock::now();
+            const auto result = tigl::xsd::parseSchema(schemaFile, backend);
+            times.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+            types = result.types.size();
+            r.allocations = tigl::AllocationCounter::allocations() - allocationsBefore;
+            r.retained = r.allocations - (tigl::AllocationCounter::deallocations() - deallocationsBefore);
+        }
+
+        r.min = *std::min_element(std::begin(times), std::end(times));
+        for (const auto& t : times)
+            r.mean += t / times.size();
+        r.types = types;
+        return r;
+    }
+}
+
+// compares the parser backends on a schema file, e.g. the full CPACS schema, or the Variant implementations,
+// or measures the generator phases on synthetic schemas of growing size, or the element index of a document
+int main(int argc, char* argv[]) {
+    tigl::AllocationCounter::enable();
+
+    if (argc >= 2 && std::string(argv[1]) == "--generator") {
+        SyntheticSchemaOptions options;
+        if (!parseGeneratorOptions(argc, argv, options)) {
+            std::cerr << "Usage: benchmarks --generator [--types N,N,...] [--fanout N] [--depth N] [--enums N] [--choices N] [--inheritance N] [--jobs N]" << std::endl;
+            return -1;
+        }
+        try {
+            runGeneratorBenchmarks(options, &tigl::AllocationCounter::allocations());
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << "Exception: " << e.what() << std::endl;
+            return -1;
+        }
+    }
+
+    if (argc >= 2 && std::string(argv[1]) == "--element-index") {
+        if (argc != 4 && argc != 5) {
+            std::cerr << "Usage: benchmarks --element-index documentFile rootXPath [iterations]" << std::endl;
+            return -1;
+        }
+        try {
+            runElementIndexBenchmarks(argv[2], argv[3], argc > 4 ? static_cast<unsigned int>(std::stoul(argv[4])) : 5u);
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << "Exception: " << e.what() << std::endl;
+            return -1;
+        }
+    }
+
+    if (argc != 2 && argc != 3) {
+        std::cerr << "Usage: benchmarks schemaFile|--variant [iterations]" << std::endl;
+        std::cerr << "       benchmarks --generator [options]" << std::endl;
+        std::cerr << "       benchmarks --element-index documentFile rootXPath [iterations]" << std::endl;
+        return -1;
+    }
+
+    const std::string schemaFile = argv[1];
+    const auto iterations = argc > 2 ? static_cast<unsigned int>(std::stoul(argv[2])) : 5u;
+
+    try {
+        if (schemaFile == "--variant") {
+            runVariantBenchmarks(iterations);
+            return 0;
+        }
+
+        const auto tixi    = measure(schemaFile, tigl::xsd::ParserBackend::Tixi,    iterations);
+        const auto libxml2 = measure(schemaFile, tigl::xsd::ParserBackend::LibXml2, iterations);
+        if (tixi.types != libxml2.types)
+            throw std::logic_error("Parser backends read a different number of types");
+
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << "Parsed " << tixi.types << " types from " << schemaFile << ", " << iterations << " iterations" << std::endl;
+        std::cout << "\tTixi    min " << std::setw(10) << tixi.min    << " ms, mean " << std::setw(10) << tixi.mean    << " ms, " << std::setw(9) << tixi.allocations    << " allocations, " << std::setw(7) << tixi.retained    << " retained" << std::endl;
+        std::cout << "\tLibXml2 min " << std::setw(10) << libxml2.min << " ms, mean " << std::setw(10) << libxml2.mean << " ms, " << std::setw(9) << libxml2.allocations << " allocations, " << std::setw(7) << libxml2.retained << " retained" << std::endl;
+        std::cout << "\tSpeedup     " << std::setw(10) << tixi.min / libxml2.min << "x" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+        return -1;
+    }
+}
@@ -0,0 +1,92 @@
+#include "AllocationCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace tigl {
+    std::atomic<bool> AllocationCounter::s_enabled{ false };
+    std::atomic<std::uint64_t> AllocationCounter::s_allocations{ 0 };
+    std::atomic<std::uint64_t> AllocationCounter::s_deallocations{ 0 };
+}
+
+namespace {
+    // like the standard operator new, calls the new handler until malloc succeeds and throws std::bad_alloc if there is none
+    auto allocate(std::size_t size) -> void* {
+        tigl::AllocationCounter::countAllocation();
+        if (size == 0)
+            size = 1;
+        while (true) {
+            if (const auto p = std::malloc(size))
+                return p;
+            const auto handler = std::get_new_handler();
+            if (!handler)
+                throw std::bad_alloc();
+            handler();
+        }
+    }
+
+    auto allocateNoThrow(std::size_t size) noexcept -> void* {
+        try {
+            return allocate(size);
+        } catch (...) {
+            return nullptr;
+        }
+    }
+
+    void deallocate(void* p) noexcept {
+        if (p)
+            tigl::AllocationCounter::countDeallocation();
+        std::free(p);
+    }
+}
+
+// all forms are replaced, so every allocation is freed by the matching replacement.
+// GCC cannot see that and warns about freeing memory from operator new with free
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size) {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocateNoThrow(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocateNoThrow(size);
+}
+
+void operator delete(void* p) noexcept {
+    deallocate(p);
+}
+
+void operator delete[](void* p) noexcept {
+    deallocate(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    deallocate(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    deallocate(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    deallocate(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    deallocate(p);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
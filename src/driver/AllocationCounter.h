@@ -0,0 +1,43 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace tigl {
+    // counts the allocations through the operator new and delete replacements in AllocationCounter.cpp,
+    // which are used by every executable linking it. Counting is off by default.
+    // libxml2 allocates with malloc and is not counted
+    class AllocationCounter {
+    public:
+        static void enable() {
+            s_enabled.store(true, std::memory_order_relaxed);
+        }
+
+        static auto enabled() -> bool {
+            return s_enabled.load(std::memory_order_relaxed);
+        }
+
+        static auto allocations() -> const std::atomic<std::uint64_t>& {
+            return s_allocations;
+        }
+
+        static auto deallocations() -> const std::atomic<std::uint64_t>& {
+            return s_deallocations;
+        }
+
+        static void countAllocation() noexcept {
+            if (enabled())
+                s_allocations.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static void countDeallocation() noexcept {
+            if (enabled())
+                s_deallocations.fetch_add(1, std::memory_order_relaxed);
+        }
+
+    private:
+        static std::atomic<bool> s_enabled;
+        static std::atomic<std::uint64_t> s_allocations;
+        static std::atomic<std::uint64_t> s_deallocations;
+    };
+}
@@ -1,13 +1,27 @@
 #include <boost/filesystem.hpp>
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "../lib/SchemaParser.h"
 #include "../lib/TypeSystem.h"
 #include "../lib/CodeGen.h"
 #include "../lib/Tables.h"
 #include "../lib/Filesystem.h"
+#include "../lib/GenerationCache.h"
+#include "../lib/Logging.h"
+#include "../lib/Hash.h"
 #include "../lib/NotImplementedException.h"
+#include "../lib/Parallel.h"
+#include "../lib/Pipeline.h"
+#include "../lib/Profiler.h"
+#include "AllocationCounter.h"
 
 namespace fs = boost::filesystem;
 
@@ -17,36 +31,77 @@ namespace tigl {
         "UniquePtr.h",
     };
 
-    void processDirectory(const std::string& inputDirectory, const std::string& runtimeDirectory, const std::string& outputDirectory, const std::string& typeSystemGraphVisFile, Filesystem& fs, const std::string& ns = "") {
+    const auto manifestFile = ".cpacsgen-manifest";
+    const auto cacheFile = ".cpacsgen-cache";
+
+    const auto tableFiles = {
+        "CustomTypes.txt",
+        "TypeSubstitution.txt",
+        "PruneList.txt",
+        "ParentPointer.txt",
+    };
+
+    // identifies the running build of the generator by the size and modification time of its executable.
+    // Returns false if the executable cannot be found
+    auto generatorFingerprint(const std::string& argv0, std::uint64_t& fingerprint) -> bool {
+        boost::system::error_code ec;
+        for (const auto& exe : { fs::path("/proc/self/exe"), fs::system_complete(argv0) }) {
+            const auto size = fs::file_size(exe, ec);
+            if (ec)
+                continue;
+            const auto mtime = fs::last_write_time(exe, ec);
+            if (ec)
+                continue;
+            fingerprint = (Hasher() << size << mtime).value();
+            return true;
+        }
+        return false;
+    }
+
+    // fingerprint of everything a schema file is generated from
+    auto passFingerprint(const fs::path& schemaFile, const std::string& inputDirectory, const std::string& ns) -> std::uint64_t {
+        Hasher h;
+        h << ns << readFile(schemaFile.string());
+        for (const auto& table : tableFiles) {
+            const auto path = fs::path(inputDirectory) / table;
+            const auto exists = fs::exists(path);
+            h << table << exists;
+            if (exists)
+                h << readFile(path.string());
+        }
+        return h.value();
+    }
+
+    // generates the code for one schema file
+    struct Pass {
+        fs::path schemaFile;
+        std::string ns;
+        std::shared_ptr<const Tables> tables;
+        std::string name;
+        std::uint64_t fingerprint;
+    };
+
+    // collects a pass for every *.xsd file in the input directory and its sub directories (namespaces), in processing order
+    void collectPasses(const std::string& inputDirectory, const std::string& typeSystemGraphVisFile, GenerationCache* cache, std::vector<Pass>& passes, const std::string& ns = "") {
         // load tables from this directory
-        const Tables tables(inputDirectory);
+        const auto tables = [&] {
+            ProfilePhase phase("loadTables", ns + "/");
+            return std::make_shared<const Tables>(inputDirectory);
+        }();
 
         // iterate all *.xsd files in the input directory
         for (const auto& e : fs::directory_iterator(inputDirectory)) {
             if (fs::is_regular_file(e) && e.path().has_extension() && e.path().extension() == ".xsd") {
-                // read types and elements
-                std::cout << "Parsing " << e.path() << std::endl;
-                auto types = xsd::parseSchema(e.path().string());
-
-                // generate type system from schema
-                std::cout << "Creating type system" << std::endl;
-                const auto& typeSystem = buildTypeSystem(types, tables);
-
-                // write graph vis file for the generated type system
-                if (!typeSystemGraphVisFile.empty()) {
-                    auto p = fs::path{ typeSystemGraphVisFile };
-                    if (p.has_parent_path())
-                        fs::create_directories(p.parent_path());
-                    writeGraphVisFile(typeSystem, typeSystemGraphVisFile);
+                // skip the schema entirely if it and the tables did not change since the last run.
+                // The type system is still needed for writing a graph vis file
+                const auto passName = ns + "/" + e.path().filename().string();
+                const auto fingerprint = cache ? passFingerprint(e.path(), inputDirectory, ns) : 0;
+                if (cache && typeSystemGraphVisFile.empty() && cache->reusePass(passName, fingerprint)) {
+                    log(LogLevel::Info) << "Skipping " << e.path() << ", no changes";
+                    continue;
                 }
 
-                // create output directory
-                const auto nsOutputDirectory = ns.empty() ? outputDirectory : outputDirectory + "/" + ns;
-                fs::create_directories(nsOutputDirectory);
-
-                // generate code
-                std::cout << "Generating classes" << std::endl;
-                genCode(nsOutputDirectory, typeSystem, ns, tables, fs);
+                passes.push_back(Pass{ e.path(), ns, tables, passName, fingerprint });
             }
         }
 
@@ -57,61 +112,298 @@ namespace tigl {
                     throw NotImplementedException("Nested input directories are not implemented. Only 1 level of subdirectories (namespaces) is allowed.");
 
                 const auto fileDir = e.path().filename().string();
-                processDirectory(e.path().string(), runtimeDirectory, outputDirectory, typeSystemGraphVisFile, fs, fileDir);
+                collectPasses(e.path().string(), typeSystemGraphVisFile, cache, passes, fileDir);
             }
         }
     }
 
-    void run(const std::string& inputDirectory, const std::string& runtimeDirectory, const std::string& outputDirectory, const std::string& typeSystemGraphVisFile) {
+    // capacity of the queues between the pipeline stages, bounds the number of passes held in memory
+    const auto pipelineQueueCapacity = 2;
+
+    // a pass moving through the pipeline
+    struct PassState {
+        std::size_t index;
+        const Pass* pass;
+        xsd::SchemaTypes types;
+        TypeSystem typeSystem;
+        std::unique_ptr<Filesystem> files;
+    };
+
+    // in streaming mode, a pass streams its files as soon as all passes before it have been flushed.
+    // Until then, they are kept in its own Filesystem, so a file generated by multiple passes is written in processing order
+    class StreamingHandOff {
+    public:
+        explicit StreamingHandOff(Filesystem& fs)
+            : m_fs(fs) {}
+
+        void beginGenerate(std::size_t index, Filesystem& files) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (index == m_head)
+                files.streamInto(m_fs);
+            else
+                m_generating[index] = &files;
+        }
+
+        void endGenerate(std::size_t index) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_generating.erase(index);
+        }
+
+        void flushed(std::size_t index) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_head = index + 1;
+            const auto it = m_generating.find(m_head);
+            if (it != std::end(m_generating)) {
+                it->second->streamInto(m_fs);
+                m_generating.erase(it);
+            }
+        }
+
+    private:
+        Filesystem& m_fs;
+        std::mutex m_mutex;
+        std::size_t m_head = 0; // first pass not flushed yet
+        std::map<std::size_t, Filesystem*> m_generating;
+    };
+
+    auto processDirectory(const std::string& inputDirectory, const std::string& outputDirectory, const std::string& typeSystemGraphVisFile, unsigned int jobs, bool streaming, Filesystem& fs, GenerationCache* cache) -> std::vector<StageStats> {
+        std::vector<Pass> passes;
+        collectPasses(inputDirectory, typeSystemGraphVisFile, cache, passes);
+        StreamingHandOff handOff(fs);
+
+        // the jobs are split among the passes processed at the same time, each of which generates and flushes on its share
+        const auto passJobs = static_cast<unsigned int>(std::max<std::size_t>(1, std::min<std::size_t>(effectiveJobCount(jobs), passes.size())));
+        const auto innerJobs = std::max(1u, effectiveJobCount(jobs) / passJobs);
+
+        // each stage works on a different pass at the same time, e.g. the next schema is parsed while the previous one is generated.
+        // The stages before flush work on up to passJobs passes at the same time.
+        // Passes share nothing but the Filesystem, each generates into its own Filesystem which the flush stage takes over in processing order.
+        // In streaming mode, the files of the pass following the last flushed one are written as soon as they are generated
+        Pipeline<PassState> pipeline(pipelineQueueCapacity);
+
+        pipeline.addStage("parse", [&](PassState& state) {
+            // read types and elements
+            log(LogLevel::Info) << "Parsing " << state.pass->schemaFile;
+            ProfilePhase phase("parseSchema", state.pass->name);
+            state.types = xsd::parseSchema(state.pass->schemaFile.string());
+        }, passJobs);
+
+        pipeline.addStage("build", [&](PassState& state) {
+            // generate type system from schema
+            log(LogLevel::Info) << "Creating type system";
+            ProfilePhase phase("buildTypeSystem", state.pass->name);
+            state.typeSystem = buildTypeSystem(std::move(state.types), *state.pass->tables);
+            state.types = {};
+        }, passJobs);
+
+        pipeline.addStage("generate", [&](PassState& state) {
+            const auto& pass = *state.pass;
+
+            // create output directory
+            const auto nsOutputDirectory = pass.ns.empty() ? outputDirectory : outputDirectory + "/" + pass.ns;
+            fs::create_directories(nsOutputDirectory);
+
+            // generate code
+            log(LogLevel::Info) << "Generating classes";
+            state.files.reset(new Filesystem);
+            if (streaming)
+                handOff.beginGenerate(state.index, *state.files);
+            try {
+                ProfilePhase phase("genCode", pass.name);
+                if (cache) {
+                    auto cachePass = cache->beginPass(pass.name, pass.fingerprint);
+                    genCode(nsOutputDirectory, state.typeSystem, pass.ns, *pass.tables, *state.files, innerJobs, &cachePass);
+                } else
+                    genCode(nsOutputDirectory, state.typeSystem, pass.ns, *pass.tables, *state.files, innerJobs);
+            } catch (...) {
+                // the pass's Filesystem must not be streamed into after it is gone
+                if (streaming)
+                    handOff.endGenerate(state.index);
+                throw;
+            }
+            if (streaming)
+                handOff.endGenerate(state.index);
+
+            // the graph vis file is written in processing order by the flush stage
+            if (typeSystemGraphVisFile.empty())
+                state.typeSystem = {};
+        }, passJobs);
+
+        pipeline.addStage("flush", [&](PassState& state) {
+            // write graph vis file for the generated type system
+            if (!typeSystemGraphVisFile.empty()) {
+                auto p = fs::path{ typeSystemGraphVisFile };
+                if (p.has_parent_path())
+                    fs::create_directories(p.parent_path());
+                writeGraphVisFile(state.typeSystem, typeSystemGraphVisFile);
+                state.typeSystem = {};
+            }
+
+            ProfilePhase phase("flushToDisk", state.pass->name);
+            fs.takeFilesFrom(*state.files);
+            fs.flushToDisk(innerJobs);
+            state.files.reset();
+            if (streaming)
+                handOff.flushed(state.index);
+        });
+
+        std::vector<PassState> states;
+        for (std::size_t i = 0; i < passes.size(); i++)
+            states.push_back(PassState{ i, &passes[i], {}, {}, nullptr });
+
+        // a single job runs each pass through all stages before starting the next one
+        pipeline.run(std::move(states), passJobs);
+        return pipeline.stats();
+    }
+
+    void printPipelineStats(const std::vector<StageStats>& stats) {
+        log(LogLevel::Info) << "\tPipeline stages (queue capacity " << pipelineQueueCapacity << "):";
+        for (const auto& s : stats) {
+            log(LogLevel::Info) << std::fixed << std::setprecision(2)
+                << "\t  " << std::left << std::setw(9) << s.name << std::right
+                << std::setw(3) << s.workers << (s.workers == 1 ? " worker,  " : " workers, ")
+                << std::setw(5) << s.items << " schemas, busy " << std::setw(7) << s.busySeconds << " s"
+                << ", stalled " << std::setw(7) << s.inputStallSeconds << " s on input, "
+                << std::setw(7) << s.outputStallSeconds << " s on output, max queue depth " << s.maxQueueDepth;
+        }
+    }
+
+    void run(const std::string& inputDirectory, const std::string& runtimeDirectory, const std::string& outputDirectory, const std::string& typeSystemGraphVisFile, unsigned int jobs, bool streaming, const std::string& argv0) {
         // create runtime output directory
         fs::create_directories(outputDirectory);
 
-        std::cout << "Copying runtime" << std::endl;
+        log(LogLevel::Info) << "Copying runtime";
         Filesystem fs;
-        for (const auto& file : runtimeFiles)
-            fs.newFile(outputDirectory + "/" + file).stream() << readFile(runtimeDirectory + "/" + file);
+        fs.useManifest(outputDirectory + "/" + manifestFile);
+        fs.setStreaming(streaming);
+        for (const auto& file : runtimeFiles) {
+            auto& f = fs.newFile(outputDirectory + "/" + file);
+            f.stream() << readFile(runtimeDirectory + "/" + file);
+            fs.closeFile(f);
+        }
+
+        // without a generator fingerprint, a changed generator could not be told apart, so nothing is reused
+        std::unique_ptr<GenerationCache> cache;
+        std::uint64_t generator = 0;
+        if (generatorFingerprint(argv0, generator))
+            cache.reset(new GenerationCache(outputDirectory + "/" + cacheFile, generator, fs));
+        else
+            log(LogLevel::Warning) << "Failed to locate the CPACSGen executable. Incremental generation is disabled";
 
         // process schema files
-        processDirectory(inputDirectory, runtimeDirectory, outputDirectory, typeSystemGraphVisFile, fs);
+        const auto stageStats = processDirectory(inputDirectory, outputDirectory, typeSystemGraphVisFile, jobs, streaming, fs, cache.get());
 
-        fs.flushToDisk();
+        {
+            ProfilePhase phase("flushToDisk");
+            fs.flushToDisk(jobs);
+        }
+        if (cache)
+            cache->save();
 
-        std::cout << "\tWrote   " << std::setw(5) << fs.newlywritten << " new files" << std::endl;
-        std::cout << "\tUpdated " << std::setw(5) << fs.overwritten << " existing files" << std::endl;
-        std::cout << "\tSkipped " << std::setw(5) << fs.skipped << " files, no changes" << std::endl;
-        std::cout << "\tDeleted " << std::setw(5) << fs.deleted << " files, pruned" << std::endl;
+        log(LogLevel::Info) << "\tWrote   " << std::setw(5) << fs.newlywritten << " new files";
+        log(LogLevel::Info) << "\tUpdated " << std::setw(5) << fs.overwritten << " existing files";
+        log(LogLevel::Info) << "\tSkipped " << std::setw(5) << fs.skipped << " files, no changes (" << fs.skippedByManifest << " unread, per manifest)";
+        log(LogLevel::Info) << "\tDeleted " << std::setw(5) << fs.deleted << " files, pruned";
+        if (cache)
+            log(LogLevel::Info) << "\tReused  " << std::setw(5) << cache->reusedFiles << " files and " << cache->reusedPasses << " schemas, unchanged inputs";
+        printPipelineStats(stageStats);
     }
 }
 
 int main(int argc, char* argv[]) {
     // parse command line arguments
-    if (argc != 4 && argc != 5) {
+    std::vector<std::string> arguments;
+    unsigned int jobs = 1;
+    bool streaming = false;
+    std::string profileFile;
+    std::string logFile;
+    auto logLevel = tigl::LogLevel::Info;
+    bool validArguments = true;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--jobs" || arg == "-j") {
+            try {
+                if (i + 1 >= argc || argv[i + 1][0] == '-')
+                    throw std::invalid_argument(arg);
+                jobs = static_cast<unsigned int>(std::stoul(argv[++i]));
+            } catch (const std::exception&) {
+                validArguments = false;
+            }
+        } else if (arg == "--stream")
+            streaming = true;
+        else if (arg == "--profile" || arg == "--log") {
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+                (arg == "--log" ? logFile : profileFile) = argv[++i];
+            else
+                validArguments = false;
+        } else if (arg == "--quiet" || arg == "-q")
+            logLevel = tigl::LogLevel::Warning;
+        else if (arg == "--verbose" || arg == "-v")
+            logLevel = tigl::LogLevel::Debug;
+        else
+            arguments.push_back(arg);
+    }
+
+    if (!validArguments || (arguments.size() != 3 && arguments.size() != 4)) {
         std::cerr
-            << "Usage: CPACSGen configDir cpascGenSourceDir outputDir [typeSystemGraphVisFile] \n\n"
-            << "Options:\n\n"
+            << "Usage: CPACSGen [options] configDir cpascGenSourceDir outputDir [typeSystemGraphVisFile] \n\n"
+            << "Arguments:\n\n"
             << "  configDir              The directory containing the CPACS schema and\n"
             << "                         the table files.\n"
             << "  runtimeDir             The directory of where the runtime source files are.\n"
             << "  outputDir              The directory to which the CPACSGen output\n"
             << "                         file are written\n"
-            << "  typeSystemGraphVisFile GraphVis file visualizing the built type system."
+            << "  typeSystemGraphVisFile GraphVis file visualizing the built type system.\n\n"
+            << "Options:\n\n"
+            << "  -j, --jobs N           Number of threads processing schemas, generating\n"
+            << "                         classes and writing files. 0 uses one thread per\n"
+            << "                         core. Default: 1\n"
+            << "  --stream               Write each file as soon as it is generated instead\n"
+            << "                         of keeping all files in memory until the end.\n"
+            << "  --profile FILE         Record wall time, CPU time, peak memory and\n"
+            << "                         allocations of each phase per schema. Writes\n"
+            << "                         FILE.json and the Chrome trace FILE.trace.json.\n"
+            << "  -q, --quiet            Only print warnings and errors.\n"
+            << "  -v, --verbose          Additionally print table contents, pruned types\n"
+            << "                         and renamed enums.\n"
+            << "  --log FILE             Write all messages including the verbose ones to\n"
+            << "                         FILE, one JSON object per line."
             << std::endl;
         return -1;
     }
 
-    const std::string inputDirectory         = argv[1];
-    const std::string runtimeDirectory       = argv[2];
-    const std::string outputDirectory        = argv[3];
-    const std::string typeSystemGraphVisFile = argc > 4 ? argv[4] : "";
+    const std::string inputDirectory         = arguments[0];
+    const std::string runtimeDirectory       = arguments[1];
+    const std::string outputDirectory        = arguments[2];
+    const std::string typeSystemGraphVisFile = arguments.size() > 3 ? arguments[3] : "";
 
+    auto& logger = tigl::Logger::instance();
     try {
-        tigl::run(inputDirectory, runtimeDirectory, outputDirectory, typeSystemGraphVisFile);
+        logger.setConsoleLevel(logLevel);
+        if (!logFile.empty())
+            logger.openFile(logFile);
+        if (!profileFile.empty()) {
+            tigl::AllocationCounter::enable();
+            tigl::Profiler::instance().enable(&tigl::AllocationCounter::allocations());
+        }
+        {
+            tigl::ProfilePhase phase("run");
+            tigl::run(inputDirectory, runtimeDirectory, outputDirectory, typeSystemGraphVisFile, jobs, streaming, argv[0]);
+        }
+        if (!profileFile.empty()) {
+            tigl::Profiler::instance().writeJson(profileFile + ".json");
+            tigl::Profiler::instance().writeChromeTrace(profileFile + ".trace.json");
+            tigl::log(tigl::LogLevel::Info) << "Wrote profile to " << profileFile << ".json and " << profileFile << ".trace.json";
+        }
+        logger.flush();
         return 0;
     } catch (const std::exception& e) {
-        std::cerr << "Exception: " << e.what() << std::endl;
+        tigl::log(tigl::LogLevel::Error) << "Exception: " << e.what();
+        logger.flush();
         return -1;
     } catch (...) {
-        std::cerr << "Unknown exception" << std::endl;
+        tigl::log(tigl::LogLevel::Error) << "Unknown exception";
+        logger.flush();
         return -1;
     }
 }
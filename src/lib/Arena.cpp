@@ -0,0 +1,76 @@
+#include "Arena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "Hash.h"
+
+namespace tigl {
+    namespace {
+        // blocks grow geometrically up to this size, so large schemas need only a few of them
+        const std::size_t c_maxBlockSize = 16 * 1024 * 1024;
+    }
+
+    Arena::Arena(std::size_t initialBlockSize)
+        : m_nextBlockSize(initialBlockSize) {}
+
+    auto Arena::allocate(std::size_t size, std::size_t alignment) -> void* {
+        auto padding = (alignment - reinterpret_cast<std::uintptr_t>(m_current) % alignment) % alignment;
+        if (!m_current || padding + size > m_remaining) {
+            // blocks from new[] are aligned for any fundamental type
+            const auto blockSize = std::max(m_nextBlockSize, size);
+            m_blocks.emplace_back(new char[blockSize]);
+            m_current = m_blocks.back().get();
+            m_remaining = blockSize;
+            m_nextBlockSize = std::min(m_nextBlockSize * 2, c_maxBlockSize);
+            padding = 0;
+        }
+
+        const auto result = m_current + padding;
+        m_current += padding + size;
+        m_remaining -= padding + size;
+        m_used += size;
+        return result;
+    }
+
+    auto Arena::intern(boost::string_view str) -> boost::string_view {
+        if (str.empty())
+            return {};
+
+        // keep the table at most half full
+        if (2 * (m_stringCount + 1) > m_strings.size()) {
+            std::vector<boost::string_view> strings(std::max<std::size_t>(1024, 2 * m_strings.size()));
+            const auto mask = strings.size() - 1;
+            for (const auto& s : m_strings) {
+                if (!s.data())
+                    continue;
+                auto i = fnv1a(s.data(), s.size()) & mask;
+                while (strings[i].data())
+                    i = (i + 1) & mask;
+                strings[i] = s;
+            }
+            m_strings = std::move(strings);
+        }
+
+        const auto mask = m_strings.size() - 1;
+        auto i = fnv1a(str.data(), str.size()) & mask;
+        for (; m_strings[i].data(); i = (i + 1) & mask)
+            if (m_strings[i] == str)
+                return m_strings[i];
+
+        const auto data = static_cast<char*>(allocate(str.size(), 1));
+        std::memcpy(data, str.data(), str.size());
+        m_strings[i] = boost::string_view(data, str.size());
+        m_stringCount++;
+        return m_strings[i];
+    }
+
+    auto Arena::blockCount() const -> std::size_t {
+        return m_blocks.size();
+    }
+
+    auto Arena::bytesUsed() const -> std::size_t {
+        return m_used;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <boost/utility/string_view.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Span.h"
+
+namespace tigl {
+    // hands out memory from a few large blocks, which are all freed together when the arena is destroyed.
+    // Destructors of the objects placed in the arena are never run, so they must not own any other resources
+    class Arena {
+    public:
+        explicit Arena(std::size_t initialBlockSize = 64 * 1024);
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        auto allocate(std::size_t size, std::size_t alignment) -> void*;
+
+        // moves the values [first, last) into the arena
+        template <typename It>
+        auto store(It first, It last) -> Span<const typename std::iterator_traits<It>::value_type> {
+            using T = typename std::iterator_traits<It>::value_type;
+            const auto count = static_cast<std::size_t>(std::distance(first, last));
+            if (count == 0)
+                return {};
+            const auto begin = static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+            auto p = begin;
+            for (; first != last; ++first)
+                new (p++) T(std::move(*first));
+            return { begin, p };
+        }
+
+        // returns a view of a copy of str inside the arena. Equal strings are stored only once
+        auto intern(boost::string_view str) -> boost::string_view;
+
+        auto blockCount() const -> std::size_t;
+        auto bytesUsed() const -> std::size_t;
+
+    private:
+        std::size_t m_nextBlockSize;
+        std::vector<std::unique_ptr<char[]>> m_blocks;
+        char* m_current = nullptr;
+        std::size_t m_remaining = 0;
+        std::size_t m_used = 0;
+
+        // open addressing hash set of the interned strings, empty slots have a null data pointer
+        std::vector<boost::string_view> m_strings;
+        std::size_t m_stringCount = 0;
+    };
+}
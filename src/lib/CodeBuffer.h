@@ -0,0 +1,110 @@
+#pragma once
+
+#include <boost/utility/string_view.hpp>
+
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+namespace tigl {
+    struct Scope;
+
+    struct EmptyLineTag {};
+    constexpr EmptyLineTag EmptyLine;
+
+    // append only buffer for generated code.
+    // Writing to it starts a new line indented by the current Scope level, further fragments are appended to that line
+    class CodeBuffer {
+    public:
+        // appends fragments to the current line
+        class Line {
+        public:
+            explicit Line(std::string& buffer)
+                : m_buffer(&buffer) {}
+
+            auto operator<<(boost::string_view str) const -> const Line& {
+                m_buffer->append(str.data(), str.size());
+                return *this;
+            }
+
+            auto operator<<(char c) const -> const Line& {
+                m_buffer->push_back(c);
+                return *this;
+            }
+
+            template <typename T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+            auto operator<<(T value) const -> const Line& {
+                return *this << std::to_string(value);
+            }
+
+        private:
+            std::string* m_buffer;
+        };
+
+        // reserve is the expected size of the generated code
+        explicit CodeBuffer(std::size_t reserve = 0) {
+            m_buffer.reserve(reserve);
+        }
+
+        // indents on first use
+        template <typename T>
+        friend auto operator<<(CodeBuffer& cb, T&& t) -> Line {
+            const auto line = cb.noIndent();
+            cb.indent();
+            line << std::forward<T>(t);
+            return line;
+        }
+
+        friend auto operator<<(CodeBuffer& cb, EmptyLineTag) -> CodeBuffer& {
+            cb.noIndent();
+            return cb;
+        }
+
+        auto contLine() -> Line {
+            return Line(m_buffer);
+        }
+
+        auto noIndent() -> Line {
+            // finish last line if we have written something before
+            if (!m_buffer.empty())
+                m_buffer.push_back('\n');
+            return Line(m_buffer);
+        }
+
+        auto str() const -> const std::string& {
+            return m_buffer;
+        }
+
+        void writeTo(std::ostream& os) const {
+            os.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        }
+
+    private:
+        friend struct Scope;
+
+        void indent() {
+            static const std::string spaces(128, ' ');
+            auto count = level * 4;
+            for (; count > spaces.size(); count -= spaces.size())
+                m_buffer.append(spaces);
+            m_buffer.append(spaces, 0, count);
+        }
+
+        std::size_t level = 0;
+        std::string m_buffer;
+    };
+
+    struct Scope {
+        Scope(CodeBuffer& cb)
+            : cb(cb) {
+            cb.level++;
+        }
+
+        ~Scope() {
+            cb.level--;
+        }
+
+    private:
+        CodeBuffer& cb;
+    };
+}
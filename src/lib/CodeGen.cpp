@@ -1,20 +1,23 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/utility/in_place_factory.hpp>
 
+#include <functional>
 #include <utility>
 #include <set>
 #include <vector>
 #include <cctype>
 #include <algorithm>
 #include <sstream>
-#include <iomanip>
 
 #include "SchemaParser.h"
 #include "Tables.h"
 #include "TypeSystem.h"
 #include "NotImplementedException.h"
-#include "IndentingStreamWrapper.h"
+#include "CodeBuffer.h"
 #include "Filesystem.h"
+#include "GenerationCache.h"
+#include "Hash.h"
+#include "Parallel.h"
 #include "CodeGen.h"
 
 namespace tigl {
@@ -28,7 +31,6 @@ namespace tigl {
         const auto tixiHelperNamespace = "tixi";
         const auto c_uidMgrName = std::string("CTiglUIDManager");
         const auto c_unboundedConstantName = "tixi::xsdUnbounded";
-        const auto c_uidRefType = std::string("stringUIDBaseType");
     }
 
     namespace {
@@ -80,33 +82,8 @@ namespace tigl {
             return false;
         }
 
-        auto hasInheritedUidField(const Class& c) -> bool {
-            for (const auto& cc : c.deps.bases)
-                if (hasUidField(*cc) || hasInheritedUidField(*cc))
-                    return true;
-            return false;
-        }
-
-        // TODO: this call recurses down the tree, if this gets too slow, we can traverse the tree once and mark all classes
-        auto selfOrBaseOrAnyChildOfSelfRequiresUidMgr(const Class& c) {
-            // UidMgr required in case class has a uid field or uid reference field
-            if (hasUidField(c) || hasUidRefField(c))
-                return true;
-            for (const auto& cc : c.deps.bases)
-                if (selfOrBaseOrAnyChildOfSelfRequiresUidMgr(*cc))
-                    return true;
-            for (const auto& cc : c.deps.children)
-                if (selfOrBaseOrAnyChildOfSelfRequiresUidMgr(*cc))
-                    return true;
-            return false;
-        }
-
-        auto requiresUidManager(const Class& c) {
-            return selfOrBaseOrAnyChildOfSelfRequiresUidMgr(c);
-        }
-
         auto requiresUidManagerField(const Class& c) {
-            return requiresUidManager(c) && !hasInheritedUidField(c);
+            return c.requiresUidManager && !c.hasInheritedUidField;
         }
 
         auto formatMaxOccurs(unsigned int maxOccurs) -> std::string {
@@ -128,16 +105,52 @@ namespace tigl {
             const std::set<std::string> uniqueElemNames(elemNames.begin(), elemNames.end());
             return uniqueElemNames.size() == elemNames.size();
         }
+
+        struct ChoiceHasher : public boost::static_visitor<> {
+            ChoiceHasher(Hasher& h)
+                : h(h) {}
+
+            void operator()(const ChoiceElement& ce) {
+                h << 0 << ce.index << ce.optionalBefore;
+            }
+
+            void operator()(const Choice& c) {
+                h << 1 << c.minOccurs << c.options.size();
+                for (const auto& cc : c.options)
+                    (*this)(cc);
+            }
+
+            void operator()(const ChoiceElements& ces) {
+                h << ces.size();
+                for (const auto& ce : ces)
+                    ce.apply_visitor(*this);
+            }
+
+            Hasher& h;
+        };
     }
 
     class CodeGen {
     public:
-        CodeGen(TypeSystem types, std::string ns, const Tables& tables)
-            : m_types(std::move(types)), m_namespace(std::move(ns)), m_tables(tables) {}
+        CodeGen(const TypeSystem& types, std::string ns, const Tables& tables)
+            : m_types(types), m_namespace(std::move(ns)), m_tables(tables) {}
+
+        void writeFiles(const std::string& outputLocation, Filesystem& fs, unsigned int jobs, GenerationCache::Pass* cache) {
+            // files are registered in a fixed order on this thread, only their content is generated in parallel
+            std::vector<std::function<void()>> writers;
 
-        void writeFiles(const std::string& outputLocation, Filesystem& fs) {
-            for (const auto& p : m_types.classes) {
-                const auto c = p.second;
+            // true if the files generated from fingerprint last time can be kept, otherwise they are recorded for next time
+            auto reuse = [&](const std::vector<std::string>& fileNames, std::uint64_t fingerprint) {
+                if (!cache)
+                    return false;
+                if (std::all_of(std::begin(fileNames), std::end(fileNames), [&](const std::string& f) { return cache->reuse(f, fingerprint); }))
+                    return true;
+                for (const auto& f : fileNames)
+                    cache->record(f, fingerprint);
+                return false;
+            };
+
+            for (const auto& c : m_types.classes) {
                 const auto hppFileName = outputLocation + "/" + c.name + ".h";
                 const auto cppFileName = outputLocation + "/" + c.name + ".cpp";
                 if (c.pruned) {
@@ -145,26 +158,43 @@ namespace tigl {
                     fs.removeIfExists(cppFileName);
                     continue;
                 }
+                if (reuse({hppFileName, cppFileName}, fingerprint(c)))
+                    continue;
 
                 auto& hpp = fs.newFile(hppFileName);
                 auto& cpp = fs.newFile(cppFileName);
-                IndentingStreamWrapper hppStream(hpp.stream());
-                IndentingStreamWrapper cppStream(cpp.stream());
-                writeClass(hppStream, cppStream, c);
+                writers.push_back([this, &fs, &hpp, &cpp, &c] {
+                    CodeBuffer hppCode(estimateHeaderSize(c));
+                    CodeBuffer cppCode(estimateSourceSize(c));
+                    writeClass(hppCode, cppCode, c);
+                    hppCode.writeTo(hpp.stream());
+                    cppCode.writeTo(cpp.stream());
+                    fs.closeFile(hpp);
+                    fs.closeFile(cpp);
+                });
             }
 
-            for (const auto& p : m_types.enums) {
-                const auto e = p.second;
+            for (const auto& e : m_types.enums) {
                 const auto hppFileName = outputLocation + "/" + e.name + ".h";
                 if (e.pruned) {
                     fs.removeIfExists(hppFileName);
                     continue;
                 }
+                if (reuse({hppFileName}, fingerprint(e)))
+                    continue;
 
                 auto& hpp = fs.newFile(hppFileName);
-                IndentingStreamWrapper hppStream(hpp.stream());
-                writeEnum(hppStream, e);
+                writers.push_back([this, &fs, &hpp, &e] {
+                    CodeBuffer hppCode(estimateHeaderSize(e));
+                    writeEnum(hppCode, e);
+                    hppCode.writeTo(hpp.stream());
+                    fs.closeFile(hpp);
+                });
             }
+
+            parallelFor(writers.size(), jobs, [&](std::size_t i) {
+                writers[i]();
+            });
         }
 
     private:
@@ -175,7 +205,7 @@ namespace tigl {
             std::vector<std::string> cppIncludes;
         };
 
-        TypeSystem m_types;
+        const TypeSystem& m_types;
         std::string m_namespace;
         const Tables& m_tables;
 
@@ -191,6 +221,89 @@ namespace tigl {
             return !c.deps.parents.empty() && (m_tables.m_parentPointers.contains(c.name) || c_allTypesGetParentPointer);
         }
 
+        // hashes everything the generated code of another class or enum may depend on when it refers to the type name
+        void hashReferencedType(Hasher& h, const std::string& name, TypeId id) const {
+            h << name << customReplacedType(name) << m_tables.m_fundamentalTypes.contains(name);
+
+            const auto referencedClass = m_types.findClass(id);
+            h << (referencedClass != nullptr);
+            if (referencedClass) {
+                const auto& c = *referencedClass;
+                h << c.pruned << hasUidField(c) << hasMandatoryUidField(c) << c.hasInheritedUidField << c.requiresUidManager << requiresParentPointer(c);
+                h << c.deps.parents.size();
+                for (const auto& p : c.deps.parents)
+                    h << p->name << customReplacedType(p->name);
+            }
+
+            const auto referencedEnum = m_types.findEnum(id);
+            h << (referencedEnum != nullptr);
+            if (referencedEnum)
+                h << referencedEnum->pruned;
+        }
+
+        // fingerprint of all inputs the generated files of a class are produced from
+        auto fingerprint(const Class& c) const -> std::uint64_t {
+            Hasher h;
+            h << m_namespace << c.originXPath << c.name << c.base << c.containsSequence << c.documentation;
+
+            h << c.fields.size();
+            for (const auto& f : c.fields) {
+                h << f.originXPath << f.cpacsName << f.xmlTypeName << f.typeName << f.xmlType << f.minOccurs << f.maxOccurs << f.defaultValue << f.documentation << f.namePostfix;
+                hashReferencedType(h, f.typeName, f.typeId);
+            }
+
+            ChoiceHasher choiceHasher(h);
+            choiceHasher(c.choices);
+
+            hashReferencedType(h, c.name, c.id);
+            hashReferencedType(h, c.base, c.baseId);
+            for (const auto* deps : {&c.deps.bases, &c.deps.deriveds, &c.deps.parents, &c.deps.children}) {
+                h << deps->size();
+                for (const auto& d : *deps)
+                    hashReferencedType(h, d->name, d->id);
+            }
+            h << c.deps.enumChildren.size();
+            for (const auto& e : c.deps.enumChildren)
+                hashReferencedType(h, e->name, e->id);
+
+            return h.value();
+        }
+
+        // fingerprint of all inputs the generated file of an enum is produced from
+        auto fingerprint(const Enum& e) const -> std::uint64_t {
+            Hasher h;
+            h << m_namespace << e.originXPath << e.name << customReplacedType(e.name);
+
+            h << e.values.size();
+            for (const auto& v : e.values)
+                h << v.cpacsName << v.name();
+
+            h << e.deps.parents.size();
+            for (const auto& p : e.deps.parents)
+                h << p->name;
+
+            return h.value();
+        }
+
+        // rough size of the generated code, based on the reference outputs in test/data, to avoid regrowing the code buffers
+        static auto estimateHeaderSize(const Class& c) -> std::size_t {
+            auto size = c.documentation.size() + 2048 + c.fields.size() * 384;
+            for (const auto& f : c.fields)
+                size += f.documentation.size();
+            return size;
+        }
+
+        static auto estimateSourceSize(const Class& c) -> std::size_t {
+            return 3072 + c.fields.size() * 1024;
+        }
+
+        static auto estimateHeaderSize(const Enum& e) -> std::size_t {
+            auto size = std::size_t{2048};
+            for (const auto& v : e.values)
+                size += 4 * v.cpacsName.size() + 160;
+            return size;
+        }
+
         auto getterSetterType(const Field& field) const -> std::string {
             const auto typeName = customReplacedType(field);
             switch (field.cardinality()) {
@@ -223,10 +336,10 @@ namespace tigl {
         auto vectorInnerTypeIsUniquePtr(const Field& field) const -> bool {
             if (field.cardinality() != Cardinality::Vector)
                 throw std::logic_error("Requested vector inner type for non-vector type");
-            return m_types.classes.find(field.typeName) != std::end(m_types.classes);
+            return m_types.findClass(field.typeId) != nullptr;
         }
 
-        void writeDocumentation(IndentingStreamWrapper& hpp, const std::string& documentation) const {
+        void writeDocumentation(CodeBuffer& hpp, const std::string& documentation) const {
             if (!documentation.empty()) {
                 std::vector<std::string> lines;
                 boost::algorithm::split(lines, documentation, boost::is_any_of("\n"));
@@ -235,7 +348,7 @@ namespace tigl {
             }
         }
 
-        void writeFields(IndentingStreamWrapper& hpp, const std::vector<Field>& fields) const {
+        void writeFields(CodeBuffer& hpp, const std::vector<Field>& fields) const {
             std::size_t length = 0;
             for (const auto& f : fields)
                 length = std::max(length, fieldType(f).length());
@@ -245,18 +358,19 @@ namespace tigl {
             });
             for (const auto& f : fields) {
                 writeDocumentation(hpp, f.documentation);
-                hpp << std::left << std::setw(length) << fieldType(f) << " " << f.fieldName() << ";";
+                const auto type = fieldType(f);
+                hpp << type << std::string(length - type.length(), ' ') << " " << f.fieldName() << ";";
 
                 if (haveAnyDocumentation || &f == &fields.back())
                     hpp << EmptyLine;
             }
         }
 
-        void writeAccessorDeclarations(IndentingStreamWrapper& hpp, const std::vector<Field>& fields) const {
+        void writeAccessorDeclarations(CodeBuffer& hpp, const std::vector<Field>& fields) const {
             for (const auto& f : fields) {
                 hpp << "TIGL_EXPORT virtual const " << getterSetterType(f) << "& Get" << capitalizeFirstLetter(f.name()) << "() const;";
                 // generate setter only for fundamental and enum types which are not vectors
-                const bool isClassType = m_types.classes.find(f.typeName) != std::end(m_types.classes);
+                const bool isClassType = m_types.findClass(f.typeId) != nullptr;
                 if (!isClassType && f.cardinality() != Cardinality::Vector) {
                     hpp << "TIGL_EXPORT virtual void Set" << capitalizeFirstLetter(f.name()) << "(const " << getterSetterType(f) << "& value);";
                 } //generate accessors for vector types
@@ -277,7 +391,7 @@ namespace tigl {
             }
         }
 
-        void writeAccessorImplementations(IndentingStreamWrapper& cpp, const std::string& className, const std::vector<Field>& fields) const {
+        void writeAccessorImplementations(CodeBuffer& cpp, const std::string& className, const std::vector<Field>& fields) const {
             for (const auto& f : fields) {
                 cpp << "const " << getterSetterType(f) << "& " << className << "::Get" << capitalizeFirstLetter(f.name()) << "() const";
                 cpp << "{";
@@ -289,7 +403,7 @@ namespace tigl {
                 cpp << EmptyLine;
 
                 // generate setter only for fundamental and enum types which are not vectors
-                const bool isClassType = m_types.classes.find(f.typeName) != std::end(m_types.classes);
+                const bool isClassType = m_types.findClass(f.typeId) != nullptr;
                 if (!isClassType && f.cardinality() != Cardinality::Vector) {
                     auto writeUidRegistration = [&](bool isOptional) {
                         if (f.name() == "uID") {
@@ -465,7 +579,7 @@ namespace tigl {
             }
         }
 
-        void writeParentPointerGetters(IndentingStreamWrapper& hpp, const Class& c) const {
+        void writeParentPointerGetters(CodeBuffer& hpp, const Class& c) const {
             if (requiresParentPointer(c)) {
                 if (c.deps.parents.size() > 1) {
                     hpp << "template<typename P>";
@@ -525,7 +639,7 @@ namespace tigl {
             }
         }
 
-        void writeUidManagerGetters(IndentingStreamWrapper& hpp, const Class& c) const {
+        void writeUidManagerGetters(CodeBuffer& hpp, const Class& c) const {
             hpp << "TIGL_EXPORT virtual CTiglUIDObject* GetNextUIDParent();";
             hpp << "TIGL_EXPORT virtual const CTiglUIDObject* GetNextUIDParent() const;";
             hpp << EmptyLine;
@@ -536,7 +650,7 @@ namespace tigl {
             }
         }
 
-        void writeParentPointerGetterImplementation(IndentingStreamWrapper& cpp, const Class& c) const {
+        void writeParentPointerGetterImplementation(CodeBuffer& cpp, const Class& c) const {
             if (requiresParentPointer(c)) {
                 if (c.deps.parents.size() == 1) {
                     for (auto isConst : { true, false }) {
@@ -556,7 +670,7 @@ namespace tigl {
             }
         }
 
-        void writeUidManagerGetterImplementation(IndentingStreamWrapper& cpp, const Class& c) const {
+        void writeUidManagerGetterImplementation(CodeBuffer& cpp, const Class& c) const {
             for (auto isConst : { true, false }) {
                 if (isConst)
                     cpp << "const CTiglUIDObject* " << c.name << "::GetNextUIDParent() const";
@@ -664,13 +778,13 @@ namespace tigl {
             }
         }
 
-        void writeIODeclarations(IndentingStreamWrapper& hpp) const {
+        void writeIODeclarations(CodeBuffer& hpp) const {
             hpp << "TIGL_EXPORT virtual void ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath);";
             hpp << "TIGL_EXPORT virtual void WriteCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath) const;";
             hpp << EmptyLine;
         }
 
-        void writeChoiceValidatorDeclaration(IndentingStreamWrapper& hpp, const Class& c) const {
+        void writeChoiceValidatorDeclaration(CodeBuffer& hpp, const Class& c) const {
             if (!c.choices.empty()) {
                 hpp << "TIGL_EXPORT bool ValidateChoices() const;";
                 hpp << EmptyLine;
@@ -704,12 +818,28 @@ namespace tigl {
             std::vector<std::string> arguments;
             if (requiresParentPointer(c))
                 arguments.push_back(parentPointerThis(parentClass));
-            if (requiresUidManager(c))
+            if (c.requiresUidManager)
                 arguments.push_back("m_uidMgr");
             return boost::join(arguments, ", ");
         }
 
-        void writeReadAttributeOrElementImplementation(IndentingStreamWrapper& cpp, const Class& c, const Field& f) const {
+        // true if the attribute or element of a field is read by a single TixiTryGet call, whose result is named value
+        auto readsByTryGet(const Field& f) const -> bool {
+            if (f.cardinality() == Cardinality::Vector)
+                return false;
+            return m_tables.m_fundamentalTypes.contains(f.typeName) || m_types.findEnum(f.typeId) != nullptr;
+        }
+
+        // call reading the attribute or element of a fundamental or enum field as type
+        auto readCall(const Field& f, const std::string& type, bool tryGet) const -> std::string {
+            const auto get = std::string(tixiHelperNamespace) + (tryGet ? "::TixiTryGet" : "::TixiGet");
+            if (isAttribute(f.xmlType))
+                return get + "Attribute<" + type + ">(tixiHandle, xpath, \"" + f.cpacsName + "\")";
+            const auto empty = f.xmlType == XMLConstruct::SimpleContent || f.xmlType == XMLConstruct::FundamentalTypeBase;
+            return get + "Element<" + type + ">(tixiHandle, xpath" + (empty ? "" : " + \"/" + f.cpacsName + "\"") + ")";
+        }
+
+        void writeReadAttributeOrElementImplementation(CodeBuffer& cpp, const Class& c, const Field& f) const {
             const bool isAtt = isAttribute(f.xmlType);
 
             // fundamental types
@@ -717,12 +847,7 @@ namespace tigl {
                 switch (f.cardinality()) {
                     case Cardinality::Optional:
                     case Cardinality::Mandatory:
-                        if (isAtt)
-                            cpp << f.fieldName() << " = " << tixiHelperNamespace << "::TixiGetAttribute<" << f.typeName << ">(tixiHandle, xpath, \"" + f.cpacsName + "\");";
-                        else {
-                            const auto empty = f.xmlType == XMLConstruct::SimpleContent || f.xmlType == XMLConstruct::FundamentalTypeBase;
-                            cpp << f.fieldName() << " = " << tixiHelperNamespace << "::TixiGetElement<" << f.typeName << ">(tixiHandle, xpath" << (empty ? "" : " + \"/" + f.cpacsName + "\"") << ");";
-                        }
+                        cpp << f.fieldName() << " = " << (readsByTryGet(f) ? "*value" : readCall(f, f.typeName, false)) << ";";
 
                         // check that mandatory string fields are not empty
                         if (f.cardinality() == Cardinality::Mandatory && f.typeName == "std::string") {
@@ -781,16 +906,12 @@ namespace tigl {
             }
 
             // enums
-            const auto itE = m_types.enums.find(f.typeName);
-            if (itE != std::end(m_types.enums)) {
-                const auto& readFunc = stringToEnumFunc(itE->second, m_tables);
+            if (const auto e = m_types.findEnum(f.typeId)) {
+                const auto& readFunc = stringToEnumFunc(*e, m_tables);
                 switch (f.cardinality()) {
                     case Cardinality::Optional:
                     case Cardinality::Mandatory:
-                        if (isAtt)
-                            cpp << f.fieldName() << " = " << readFunc << "(" << tixiHelperNamespace << "::TixiGetAttribute<std::string>(tixiHandle, xpath, \"" + f.cpacsName + "\"));";
-                        else
-                            cpp << f.fieldName() << " = " << readFunc << "(" << tixiHelperNamespace << "::TixiGetElement<std::string>(tixiHandle, xpath + \"/" + f.cpacsName + "\"));";
+                        cpp << f.fieldName() << " = " << readFunc << "(" << (readsByTryGet(f) ? "*value" : readCall(f, "std::string", false)) << ");";
                         break;
                     case Cardinality::Vector:
                         throw NotImplementedException("Reading enum vectors is not implemented");
@@ -799,14 +920,13 @@ namespace tigl {
             }
 
             // classes
-            const auto itC = m_types.classes.find(f.typeName);
-            if (itC != std::end(m_types.classes)) {
+            if (const auto fc = m_types.findClass(f.typeId)) {
                 if (f.xmlType == XMLConstruct::Attribute || f.xmlType == XMLConstruct::FundamentalTypeBase)
                     throw std::logic_error("fields of class type cannot be attributes or fundamental type bases");
 
                 switch (f.cardinality()) {
                     case Cardinality::Optional:
-                        cpp << f.fieldName() << " = boost::in_place(" << ctorArgumentList(itC->second, c) << ");";
+                        cpp << f.fieldName() << " = boost::in_place(" << ctorArgumentList(*fc, c) << ");";
                         if (c_generateTryCatchAroundOptionalClassReads) {
                             cpp << "try {";
                             {
@@ -827,7 +947,7 @@ namespace tigl {
                         cpp << f.fieldName() << ".ReadCPACS(tixiHandle, xpath + \"/" + f.cpacsName + "\");";
                         break;
                     case Cardinality::Vector:
-                        const auto moreArgs = ctorArgumentList(itC->second, c);
+                        const auto moreArgs = ctorArgumentList(*fc, c);
                         cpp << tixiHelperNamespace << "::TixiReadElements(tixiHandle, xpath + \"/" << f.cpacsName << "\", " << f.fieldName() << ", " << f.minOccurs << ", " << formatMaxOccurs(f.maxOccurs) << (moreArgs.empty() ? "" : ", " + moreArgs) << ");";
                         break;
                 }
@@ -837,7 +957,7 @@ namespace tigl {
             throw std::logic_error("No read function provided for type " + f.typeName);
         }
 
-        void writeWriteAttributeOrElementImplementation(IndentingStreamWrapper& cpp, const Field& f, bool inSequence) const {
+        void writeWriteAttributeOrElementImplementation(CodeBuffer& cpp, const Field& f, bool inSequence) const {
             const auto isAtt = isAttribute(f.xmlType);
             const auto empty = f.xmlType == XMLConstruct::SimpleContent || f.xmlType == XMLConstruct::FundamentalTypeBase;
 
@@ -846,7 +966,7 @@ namespace tigl {
                     if (inSequence)
                         cpp << tixiHelperNamespace << "::TixiCreateSequenceElementIfNotExists(tixiHandle, xpath + \"/" + f.cpacsName + "\", childElemOrder);";
                     else
-                        cpp << tixiHelperNamespace << "::TixiCreateElementIfNotExists(tixiHandle, xpath + \"/" + f.cpacsName + "\");";
+                        cpp << tixiHelperNamespace << "::TixiCreateElementIfNotExistsIndexed(tixiHandle, xpath + \"/" + f.cpacsName + "\");";
             };
 
             auto writeOptionalAttributeOrElement = [&](std::function<void()> writeReadFunc) { // make parameter auto when C++14 available
@@ -867,9 +987,9 @@ namespace tigl {
                     {
                         Scope s(cpp);
                         if (isAtt)
-                            cpp << tixiHelperNamespace << "::TixiRemoveAttribute(tixiHandle, xpath, \"" + f.cpacsName + "\");";
+                            cpp << tixiHelperNamespace << "::TixiRemoveAttributeIndexed(tixiHandle, xpath, \"" + f.cpacsName + "\");";
                         else
-                            cpp << tixiHelperNamespace << "::TixiRemoveElement(tixiHandle, xpath" << (empty ? "" : " + \"/" + f.cpacsName + "\"") << ");";
+                            cpp << tixiHelperNamespace << "::TixiRemoveElementIndexed(tixiHandle, xpath" << (empty ? "" : " + \"/" + f.cpacsName + "\"") << ");";
                     }
                     cpp << "}";
                 }
@@ -882,17 +1002,17 @@ namespace tigl {
                     case Cardinality::Optional:
                         writeOptionalAttributeOrElement([&] {
                             if (isAtt)
-                                cpp << tixiHelperNamespace << "::TixiSaveAttribute(tixiHandle, xpath, \"" + f.cpacsName + "\", *" << f.fieldName() << ");";
+                                cpp << tixiHelperNamespace << "::TixiSaveAttributeIndexed(tixiHandle, xpath, \"" + f.cpacsName + "\", *" << f.fieldName() << ");";
                             else
-                                cpp << tixiHelperNamespace << "::TixiSaveElement(tixiHandle, xpath" << (empty ? "" : " + \"/" + f.cpacsName + "\"") << ", *" << f.fieldName() << ");";
+                                cpp << tixiHelperNamespace << "::TixiSaveElementIndexed(tixiHandle, xpath" << (empty ? "" : " + \"/" + f.cpacsName + "\"") << ", *" << f.fieldName() << ");";
                         });
                         break;
                     case Cardinality::Mandatory:
                         createElement();
                         if (isAtt)
-                            cpp << tixiHelperNamespace << "::TixiSaveAttribute(tixiHandle, xpath, \"" + f.cpacsName + "\", " << f.fieldName() << ");";
+                            cpp << tixiHelperNamespace << "::TixiSaveAttributeIndexed(tixiHandle, xpath, \"" + f.cpacsName + "\", " << f.fieldName() << ");";
                         else
-                            cpp << tixiHelperNamespace << "::TixiSaveElement(tixiHandle, xpath" << (empty ? "" : " + \"/" + f.cpacsName + "\"") << ", " << f.fieldName() << ");";
+                            cpp << tixiHelperNamespace << "::TixiSaveElementIndexed(tixiHandle, xpath" << (empty ? "" : " + \"/" + f.cpacsName + "\"") << ", " << f.fieldName() << ");";
                         break;
                     case Cardinality::Vector:
                         if (f.xmlType == XMLConstruct::Attribute || f.xmlType == XMLConstruct::SimpleContent || f.xmlType == XMLConstruct::FundamentalTypeBase)
@@ -906,17 +1026,16 @@ namespace tigl {
             }
 
             // enums
-            const auto itE = m_types.enums.find(f.typeName);
-            if (itE != std::end(m_types.enums)) {
+            if (const auto e = m_types.findEnum(f.typeId)) {
                 switch (f.cardinality()) {
                     case Cardinality::Optional:
                         writeOptionalAttributeOrElement([&] {
-                            cpp << tixiHelperNamespace << "::TixiSave" << (isAtt ? "Attribute" : "Element") << "(tixiHandle, xpath" << (isAtt ? ", \"" : " + \"/") << f.cpacsName + "\", " << enumToStringFunc(itE->second, m_tables) << "(*" << f.fieldName() << "));";
+                            cpp << tixiHelperNamespace << "::TixiSave" << (isAtt ? "Attribute" : "Element") << "Indexed(tixiHandle, xpath" << (isAtt ? ", \"" : " + \"/") << f.cpacsName + "\", " << enumToStringFunc(*e, m_tables) << "(*" << f.fieldName() << "));";
                         });
                         break;
                     case Cardinality::Mandatory:
                         createElement();
-                        cpp << tixiHelperNamespace << "::TixiSave" << (isAtt ? "Attribute" : "Element") << "(tixiHandle, xpath" << (isAtt ? ", \"" : " + \"/") << f.cpacsName + "\", " << enumToStringFunc(itE->second, m_tables) << "(" << f.fieldName() << "));";
+                        cpp << tixiHelperNamespace << "::TixiSave" << (isAtt ? "Attribute" : "Element") << "Indexed(tixiHandle, xpath" << (isAtt ? ", \"" : " + \"/") << f.cpacsName + "\", " << enumToStringFunc(*e, m_tables) << "(" << f.fieldName() << "));";
                         break;
                     case Cardinality::Vector:
                         throw NotImplementedException("Writing enum vectors is not implemented");
@@ -926,8 +1045,7 @@ namespace tigl {
 
             // classes
             if (f.xmlType != XMLConstruct::Attribute && f.xmlType != XMLConstruct::FundamentalTypeBase) {
-                const auto itC = m_types.classes.find(f.typeName);
-                if (itC != std::end(m_types.classes)) {
+                if (m_types.findClass(f.typeId)) {
                     switch (f.cardinality()) {
                         case Cardinality::Optional:
                             writeOptionalAttributeOrElement([&] {
@@ -949,14 +1067,13 @@ namespace tigl {
             throw std::logic_error("No write function provided for type " + f.typeName);
         }
 
-        void writeReadBaseImplementation(IndentingStreamWrapper& cpp, const std::string& type) const {
+        void writeReadBaseImplementation(CodeBuffer& cpp, const std::string& type, TypeId typeId) const {
             // fundamental types
             if (m_tables.m_fundamentalTypes.contains(type))
                 throw std::logic_error("fundamental types cannot be base classes"); // this should be prevented by TypeSystemBuilder
 
             // classes
-            const auto itC = m_types.classes.find(type);
-            if (itC != std::end(m_types.classes)) {
+            if (m_types.findClass(typeId)) {
                 cpp << type << "::ReadCPACS(tixiHandle, xpath);";
                 return;
             }
@@ -964,16 +1081,15 @@ namespace tigl {
             throw std::logic_error("No read function provided for type " + type);
         }
 
-        void writeWriteBaseImplementation(IndentingStreamWrapper& cpp, const std::string& type) const {
+        void writeWriteBaseImplementation(CodeBuffer& cpp, const std::string& type, TypeId typeId) const {
             // fundamental types
             if (m_tables.m_fundamentalTypes.contains(type)) {
-                cpp << tixiHelperNamespace << "::TixiSaveElement(tixiHandle, xpath, *this);";
+                cpp << tixiHelperNamespace << "::TixiSaveElementIndexed(tixiHandle, xpath, *this);";
                 return;
             }
 
             // classes
-            const auto itC = m_types.classes.find(type);
-            if (itC != std::end(m_types.classes)) {
+            if (m_types.findClass(typeId)) {
                 cpp << type << "::WriteCPACS(tixiHandle, xpath);";
                 return;
             }
@@ -981,7 +1097,7 @@ namespace tigl {
             throw std::logic_error("No write function provided for type " + type);
         }
 
-        void writeReadImplementation(IndentingStreamWrapper& cpp, const Class& c, const std::vector<Field>& fields) const {
+        void writeReadImplementation(CodeBuffer& cpp, const Class& c, const std::vector<Field>& fields) const {
             cpp << "void " << c.name << "::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)";
             cpp << "{";
             {
@@ -990,7 +1106,7 @@ namespace tigl {
                 // base class
                 if (!c.base.empty()) {
                     cpp << "// read base";
-                    writeReadBaseImplementation(cpp, c.base);
+                    writeReadBaseImplementation(cpp, c.base, c.baseId);
                     cpp << EmptyLine;
                 }
 
@@ -999,11 +1115,14 @@ namespace tigl {
                     const auto construct = xmlConstructToString(f.xmlType);
                     const auto isAtt = isAttribute(f.xmlType);
                     cpp << "// read " << construct << " " << f.cpacsName << "";
-                    if (isAtt)
-                        cpp << "if (" << tixiHelperNamespace << "::TixiCheckAttribute(tixiHandle, xpath, \"" << f.cpacsName << "\")) {";
+                    if (readsByTryGet(f)) {
+                        const auto type = m_types.findEnum(f.typeId) ? std::string("std::string") : f.typeName;
+                        cpp << "if (const boost::optional<" << type << "> value = " << readCall(f, type, true) << ") {";
+                    } else if (isAtt)
+                        cpp << "if (" << tixiHelperNamespace << "::TixiCheckAttributeIndexed(tixiHandle, xpath, \"" << f.cpacsName << "\")) {";
                     else {
                         const auto empty = f.xmlType == XMLConstruct::SimpleContent || f.xmlType == XMLConstruct::FundamentalTypeBase;
-                        cpp << "if (" << tixiHelperNamespace << "::TixiCheckElement(tixiHandle, xpath" << (empty ? "" : " + \"/" + f.cpacsName + "\"") << ")) {";
+                        cpp << "if (" << tixiHelperNamespace << "::TixiCheckElementIndexed(tixiHandle, xpath" << (empty ? "" : " + \"/" + f.cpacsName + "\"") << ")) {";
                     }
                     {
                         Scope s(cpp);
@@ -1044,7 +1163,7 @@ namespace tigl {
             cpp << EmptyLine;
         }
 
-        void writeWriteImplementation(IndentingStreamWrapper& cpp, const Class& c, const std::vector<Field>& fields) const {
+        void writeWriteImplementation(CodeBuffer& cpp, const Class& c, const std::vector<Field>& fields) const {
             cpp << "void " << c.name << "::WriteCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath) const";
             cpp << "{";
             {
@@ -1060,7 +1179,7 @@ namespace tigl {
                 // base class
                 if (!c.base.empty()) {
                     cpp << "// write base";
-                    writeWriteBaseImplementation(cpp, c.base);
+                    writeWriteBaseImplementation(cpp, c.base, c.baseId);
                     cpp << EmptyLine;
                 }
 
@@ -1078,7 +1197,7 @@ namespace tigl {
             cpp << EmptyLine;
         }
 
-        static auto writeIsFieldThere(IndentingStreamWrapper& cpp, const Field& f) {
+        static auto writeIsFieldThere(CodeBuffer& cpp, const Field& f) {
             if (f.cardinality() == Cardinality::Optional)
                 cpp << f.fieldName() + ".is_initialized()";
             else if (f.cardinality() == Cardinality::Vector)
@@ -1087,7 +1206,7 @@ namespace tigl {
                 throw std::logic_error("elements inside choice can only be optional or vector");
         }
 
-        void writeChoiceValidatorImplementation(IndentingStreamWrapper& cpp, const Class& c) const {
+        void writeChoiceValidatorImplementation(CodeBuffer& cpp, const Class& c) const {
             if (!c.choices.empty()) {
                 cpp << "bool " << c.name << "::ValidateChoices() const";
                 cpp << "{";
@@ -1115,7 +1234,7 @@ namespace tigl {
                     };
 
                     struct ChoiceWriter : public boost::static_visitor<> {
-                        ChoiceWriter(IndentingStreamWrapper& cpp, const Class& c)
+                        ChoiceWriter(CodeBuffer& cpp, const Class& c)
                             : cpp(cpp), c(c) {}
 
                         void operator()(const ChoiceElement& ce) {
@@ -1237,7 +1356,7 @@ namespace tigl {
                         }
 
                     private:
-                        IndentingStreamWrapper& cpp;
+                        CodeBuffer& cpp;
                         const Class& c;
                     };
 
@@ -1250,9 +1369,9 @@ namespace tigl {
             }
         }
 
-        void writeTreeManipulatorDeclarations(IndentingStreamWrapper& hpp, const std::vector<Field>& fields) const {
+        void writeTreeManipulatorDeclarations(CodeBuffer& hpp, const std::vector<Field>& fields) const {
             for (const auto& f : fields) {
-                if (m_types.classes.find(f.typeName) != std::end(m_types.classes)) {
+                if (m_types.findClass(f.typeId) != nullptr) {
                     if (f.xmlType == XMLConstruct::Attribute || f.xmlType == XMLConstruct::FundamentalTypeBase)
                         throw std::logic_error("fields of class type cannot be attributes or fundamental type bases");
 
@@ -1272,10 +1391,9 @@ namespace tigl {
             }
         }
 
-        void writeTreeManipulatorImplementations(IndentingStreamWrapper& cpp, const Class& c) const {
+        void writeTreeManipulatorImplementations(CodeBuffer& cpp, const Class& c) const {
             for (const auto& f : c.fields) {
-                const auto itC = m_types.classes.find(f.typeName);
-                if (itC != std::end(m_types.classes)) {
+                if (const auto fc = m_types.findClass(f.typeId)) {
                     if (f.xmlType == XMLConstruct::Attribute || f.xmlType == XMLConstruct::FundamentalTypeBase)
                         throw std::logic_error("fields of class type cannot be attributes or fundamental type bases");
 
@@ -1288,7 +1406,7 @@ namespace tigl {
                                 cpp << "if (!" << f.fieldName() << ")";
                                 {
                                     Scope s(cpp);
-                                    cpp << f.fieldName() << " = boost::in_place(" << ctorArgumentList(itC->second, c) << ");";
+                                    cpp << f.fieldName() << " = boost::in_place(" << ctorArgumentList(*fc, c) << ");";
                                 }
                                 cpp << "return *" << f.fieldName() << ";";
                             }
@@ -1308,7 +1426,7 @@ namespace tigl {
                             cpp << "{";
                             {
                                 Scope s(cpp);
-                                cpp << f.fieldName() << ".push_back(make_unique<" << customReplacedType(f) << ">(" << ctorArgumentList(itC->second, c) << "));";
+                                cpp << f.fieldName() << ".push_back(make_unique<" << customReplacedType(f) << ">(" << ctorArgumentList(*fc, c) << "));";
                                 cpp << "return *" << f.fieldName() << ".back();";
                             }
                             cpp << "}";
@@ -1339,13 +1457,13 @@ namespace tigl {
             }
         }
 
-        void writeUidRefObjectFunctionDeclaractions(IndentingStreamWrapper& hpp) const {
+        void writeUidRefObjectFunctionDeclaractions(CodeBuffer& hpp) const {
             hpp << "TIGL_EXPORT const CTiglUIDObject* GetNextUIDObject() const final;";
             hpp << "TIGL_EXPORT void NotifyUIDChange(const std::string& oldUid, const std::string& newUid) final;";
             hpp << EmptyLine;
         }
 
-        void writeUidRefObjectFunctionImplementations(IndentingStreamWrapper& cpp, const Class& c) const {
+        void writeUidRefObjectFunctionImplementations(CodeBuffer& cpp, const Class& c) const {
             cpp << "const CTiglUIDObject* " << c.name << "::GetNextUIDObject() const";
             cpp << "{";
             {
@@ -1397,7 +1515,7 @@ namespace tigl {
             cpp << EmptyLine;
         }
 
-        void writeLicenseHeader(IndentingStreamWrapper& f) const {
+        void writeLicenseHeader(CodeBuffer& f) const {
             f << "// Copyright (c) 2020 RISC Software GmbH";
             f << "//";
             f << "// This file was generated by CPACSGen from CPACS XML Schema (c) German Aerospace Center (DLR/SC).";
@@ -1434,12 +1552,12 @@ namespace tigl {
                 switch (f.cardinality()) {
                     case Cardinality::Optional:
                         optionalHeader = true;
-                        if (m_types.classes.find(f.typeName) != std::end(m_types.classes))
+                        if (m_types.findClass(f.typeId) != nullptr)
                             createIfNotExistsHeader = true;
                         break;
                     case Cardinality::Vector:
                         vectorHeader = true;
-                        if (m_types.classes.find(f.typeName) != std::end(m_types.classes))
+                        if (m_types.findClass(f.typeId) != nullptr)
                             makeUnique = true;
                         break;
                     case Cardinality::Mandatory:
@@ -1466,7 +1584,7 @@ namespace tigl {
                 deps.hppIncludes.push_back("\"CTiglError.h\"");
                 deps.hppIncludes.push_back("<typeinfo>");
             }
-            if (requiresUidManager(c)) {
+            if (c.requiresUidManager) {
                 deps.hppCustomForwards.push_back(c_uidMgrName);
                 deps.cppIncludes.push_back("\"" + c_uidMgrName + ".h\"");
             }
@@ -1482,14 +1600,14 @@ namespace tigl {
             }
 
             // base class
-            if (!c.base.empty() && m_types.classes.find(c.base) != std::end(m_types.classes)) {
+            if (!c.base.empty() && m_types.findClass(c.baseId) != nullptr) {
                 deps.hppIncludes.push_back("\"" + c.base + ".h\"");
             }
 
             // fields
             for (const auto& f : c.fields) {
-                if (m_types.enums.find(f.typeName) != std::end(m_types.enums) ||
-                    m_types.classes.find(f.typeName) != std::end(m_types.classes)) {
+                if (m_types.findEnum(f.typeId) != nullptr ||
+                    m_types.findClass(f.typeId) != nullptr) {
                     // this is a class or enum type, include it
 
                     const auto p = m_tables.m_customTypes.find(f.typeName);
@@ -1560,8 +1678,8 @@ namespace tigl {
             return deps;
         }
 
-        void writeCtors(IndentingStreamWrapper& hpp, const Class& c) const {
-            const auto hasUid = requiresUidManager(c);
+        void writeCtors(CodeBuffer& hpp, const Class& c) const {
+            const auto hasUid = c.requiresUidManager;
             if (requiresParentPointer(c)) {
                 if (c_generateDefaultCtorsForParentPointerTypes)
                     hpp << "TIGL_EXPORT " << c.name << "(" << (hasUid ? c_uidMgrName + "* uidMgr" : "") << ");";
@@ -1573,7 +1691,7 @@ namespace tigl {
             }
         }
 
-        void writeParentPointerFields(IndentingStreamWrapper& hpp, const Class& c) const {
+        void writeParentPointerFields(CodeBuffer& hpp, const Class& c) const {
             if (requiresParentPointer(c)) {
                 if (c.deps.parents.size() > 1) {
                     hpp << "void* m_parent;";
@@ -1585,14 +1703,14 @@ namespace tigl {
             }
         }
 
-        void writeUidManagerFields(IndentingStreamWrapper& hpp, const Class& c) const {
+        void writeUidManagerFields(CodeBuffer& hpp, const Class& c) const {
             if (requiresUidManagerField(c)) {
                 hpp << c_uidMgrName << "* m_uidMgr;";
                 hpp << EmptyLine;
             }
         }
 
-        void writeDeletedCTorAndAssign(IndentingStreamWrapper& hpp, const Class& c) const {
+        void writeDeletedCTorAndAssign(CodeBuffer& hpp, const Class& c) const {
             hpp << c.name << "(const " << c.name << "&) = delete;";
             hpp << "" << c.name << "& operator=(const " << c.name << "&) = delete;";
             hpp << EmptyLine;
@@ -1608,8 +1726,8 @@ namespace tigl {
                 return "this";
         }
 
-        void writeCtorImplementations(IndentingStreamWrapper& cpp, const Class& c) const {
-            const auto hasUidArgument = requiresUidManager(c);
+        void writeCtorImplementations(CodeBuffer& cpp, const Class& c) const {
+            const auto hasUidArgument = c.requiresUidManager;
             const auto hasUidMgrField = requiresUidManagerField(c);
 
             auto writeInitializationList = [&] {
@@ -1624,7 +1742,7 @@ namespace tigl {
                     cpp.contLine() << baseOrMemberName << "(" << value << ")";
                 };
                 for (const auto& bc : c.deps.bases) {
-                    if (requiresUidManager(*bc)) {
+                    if (bc->requiresUidManager) {
                         writeBaseOrMember(bc->name, "uidMgr");
                     }
                 }
@@ -1641,9 +1759,8 @@ namespace tigl {
                             if (!args.empty())
                                 writeBaseOrMember(f.fieldName(), args);
                         } else {
-                            const auto fci = m_types.classes.find(f.typeName);
-                            if (fci != std::end(m_types.classes)) {
-                                const auto args = ctorArgumentList(fci->second, c);
+                            if (const auto fc = m_types.findClass(f.typeId)) {
+                                const auto args = ctorArgumentList(*fc, c);
                                 if (!args.empty())
                                     writeBaseOrMember(f.fieldName(), args);
                             }
@@ -1691,12 +1808,12 @@ namespace tigl {
             }
         }
 
-        void writeDtor(IndentingStreamWrapper& hpp, const Class& c) const {
+        void writeDtor(CodeBuffer& hpp, const Class& c) const {
             hpp << "TIGL_EXPORT virtual ~" << c.name << "();";
             hpp << EmptyLine;
         }
 
-        void writeDtorImplementation(IndentingStreamWrapper& cpp, const Class& c) const {
+        void writeDtorImplementation(CodeBuffer& cpp, const Class& c) const {
             auto writeUidRefUnregistration = [&] {
                 const auto fields = uidReferenceFields(c);
                 if (!fields.empty()) {
@@ -1738,7 +1855,7 @@ namespace tigl {
             cpp << EmptyLine;
         }
 
-        void writeHeader(IndentingStreamWrapper& hpp, const Class& c, const Includes& includes) const {
+        void writeHeader(CodeBuffer& hpp, const Class& c, const Includes& includes) const {
             // file header
             writeLicenseHeader(hpp);
 
@@ -1906,7 +2023,7 @@ namespace tigl {
             hpp << EmptyLine;
         }
 
-        void writeChildElemOrder(IndentingStreamWrapper& cpp, const Class& c) const {
+        void writeChildElemOrder(CodeBuffer& cpp, const Class& c) const {
             const auto elemNames = elementNames(c);
             cpp << "const std::vector<std::string> childElemOrder = { " << [&] {
                 std::stringstream ss;
@@ -1920,7 +2037,7 @@ namespace tigl {
             cpp << EmptyLine;
         }
 
-        void writeSource(IndentingStreamWrapper& cpp, const Class& c, const Includes& includes) const {
+        void writeSource(CodeBuffer& cpp, const Class& c, const Includes& includes) const {
             // file header
             writeLicenseHeader(cpp);
 
@@ -1985,7 +2102,7 @@ namespace tigl {
             cpp << EmptyLine;
         }
 
-        void writeClass(IndentingStreamWrapper& hpp, IndentingStreamWrapper& cpp, const Class& c) const {
+        void writeClass(CodeBuffer& hpp, CodeBuffer& cpp, const Class& c) const {
             const auto includes = resolveIncludes(c);
             writeHeader(hpp, c, includes);
             writeSource(cpp, c, includes);
@@ -2010,7 +2127,7 @@ namespace tigl {
             return name;
         }
 
-        void writeEnum(IndentingStreamWrapper& hpp, const Enum& e) const {
+        void writeEnum(CodeBuffer& hpp, const Enum& e) const {
             // file header
             writeLicenseHeader(hpp);
 
@@ -2136,8 +2253,8 @@ namespace tigl {
         }
     };
 
-    void genCode(const std::string& outputLocation, TypeSystem typeSystem, const std::string& ns, const Tables& tables, Filesystem& fs) {
-        CodeGen gen(std::move(typeSystem), ns, tables);
-        gen.writeFiles(outputLocation, fs);
+    void genCode(const std::string& outputLocation, const TypeSystem& typeSystem, const std::string& ns, const Tables& tables, Filesystem& fs, unsigned int jobs, GenerationCache::Pass* cache) {
+        CodeGen gen(typeSystem, ns, tables);
+        gen.writeFiles(outputLocation, fs, jobs, cache);
     }
 }
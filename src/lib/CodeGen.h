@@ -2,10 +2,14 @@
 
 #include <string>
 
+#include "GenerationCache.h"
+
 namespace tigl {
     struct TypeSystem;
     class Tables;
     class Filesystem;
 
-    void genCode(const std::string& outputLocation, TypeSystem typeSystem, const std::string& ns, const Tables& tables, Filesystem& fs);
+    // jobs is the number of threads generating classes and enums, 0 uses one thread per core.
+    // If cache is given, classes and enums whose files were generated from the same inputs before are not generated again
+    void genCode(const std::string& outputLocation, const TypeSystem& typeSystem, const std::string& ns, const Tables& tables, Filesystem& fs, unsigned int jobs = 1, GenerationCache::Pass* cache = nullptr);
 }
@@ -2,7 +2,13 @@
 
 #include <algorithm>
 #include <fstream>
+#include <stdexcept>
+#include <unordered_map>
 #include <utility>
+#include <vector>
+
+#include "Hash.h"
+#include "Parallel.h"
 
 namespace tigl {
 	auto readFile(const boost::filesystem::path& filename) -> std::string {
@@ -21,7 +27,7 @@ namespace tigl {
 	}
 
 	File::File(boost::filesystem::path filename)
-		: m_stream(new std::ostringstream), m_filename(std::move(filename)) {}
+		: m_stream(new std::stringstream), m_filename(std::move(filename)) {}
 
 	auto File::path() const -> const boost::filesystem::path&
 	{
@@ -32,55 +38,314 @@ namespace tigl {
 		return *m_stream;
 	}
 
-	void Filesystem::flushToDisk() {
-		for (auto& file : m_files) {
-			const auto& newContent = file.m_stream->str();
+	namespace {
+		const auto c_manifestHeader = std::string("CPACSGen manifest 1");
 
-			// check if a file already exists
-			if (boost::filesystem::exists(file.m_filename)) {
-				// read existing file to string and compare
-				const auto& content = readFile(file.m_filename);
+		// the manifest entry is only trusted if the file on disk was not touched since it was recorded.
+		// Modification times have a resolution of one second, so a file modified in the second it was recorded or later
+		// could have been changed again without its time changing. Like git's racy clean entries, such entries are never trusted
+		auto matchesDisk(const boost::filesystem::path& path, std::uintmax_t size, std::time_t mtime, std::time_t manifestTime) -> bool {
+			if (mtime >= manifestTime)
+				return false;
+			boost::system::error_code ec;
+			const auto diskSize = boost::filesystem::file_size(path, ec);
+			if (ec || diskSize != size)
+				return false;
+			const auto diskMTime = boost::filesystem::last_write_time(path, ec);
+			return !ec && diskMTime == mtime;
+		}
+	}
 
-				// if existing file has same content, skip overwriting it
-				if (content == newContent) {
-					skipped++;
-					continue;
-				}
+	auto Filesystem::flushFile(const File& file, const ManifestEntry* recorded, std::time_t manifestTime, ManifestEntry* entry) -> FlushResult {
+		const auto& newContent = file.m_stream->str();
 
-				overwritten++;
+		if (entry) {
+			entry->hash = fnv1a(newContent);
+			entry->size = newContent.size();
+		}
+
+		auto result = FlushResult::Written;
+
+		// check if a file already exists
+		if (boost::filesystem::exists(file.m_filename)) {
+			// if the manifest recorded the same content and the file is untouched, skip it without reading
+			if (recorded && entry && recorded->hash == entry->hash && recorded->size == entry->size && matchesDisk(file.m_filename, recorded->size, recorded->mtime, manifestTime)) {
+				entry->mtime = recorded->mtime;
+				return FlushResult::SkippedByManifest;
 			}
+
+			// read existing file to string and compare
+			const auto& content = readFile(file.m_filename);
+
+			// if existing file has same content, skip overwriting it
+			if (content == newContent)
+				result = FlushResult::Skipped;
 			else
-				newlywritten++;
+				result = FlushResult::Overwritten;
+		}
 
+		if (result != FlushResult::Skipped) {
 			// write new content to file
 			std::ofstream f(file.m_filename.string());
 			f.exceptions(std::ios::failbit | std::ios::badbit);
 			f.write(newContent.c_str(), newContent.size());
 			f.close();
 		}
+
+		if (entry)
+			entry->mtime = boost::filesystem::last_write_time(file.m_filename);
+
+		return result;
+	}
+
+	void Filesystem::flushToDisk(unsigned int jobs) {
+		const auto useManifest = !m_manifestFile.empty();
+
+		// files registered multiple times under the same path are flushed by the same job in registration order.
+		// The manifest entries are copied, so the manifest can be queried by other threads while flushing
+		std::vector<std::vector<File*>> groups;
+		std::vector<boost::optional<ManifestEntry>> recordedEntries;
+		std::time_t manifestTime = 0;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			manifestTime = m_manifestTime;
+			std::unordered_map<std::string, std::size_t> groupIndices;
+			for (auto& file : m_files) {
+				if (!file.m_stream)
+					continue; // already flushed
+				const auto it = groupIndices.insert(std::make_pair(file.m_filename.string(), groups.size())).first;
+				if (it->second == groups.size()) {
+					groups.emplace_back();
+					recordedEntries.emplace_back();
+					if (useManifest) {
+						const auto mit = m_manifest.find(it->first);
+						if (mit != std::end(m_manifest))
+							recordedEntries.back() = mit->second;
+					}
+				}
+				groups[it->second].push_back(&file);
+			}
+		}
+
+		std::vector<std::vector<std::pair<FlushResult, ManifestEntry>>> results(groups.size());
+		parallelFor(groups.size(), jobs, [&](std::size_t i) {
+			const ManifestEntry* recorded = recordedEntries[i].get_ptr();
+
+			auto& groupResults = results[i];
+			groupResults.reserve(groups[i].size());
+			for (const auto& file : groups[i]) {
+				ManifestEntry entry;
+				const auto r = flushFile(*file, recorded, manifestTime, useManifest ? &entry : nullptr);
+				groupResults.emplace_back(r, entry);
+				recorded = &groupResults.back().second;
+
+				// release the content, so a later flush only writes files added since
+				file->m_stream.reset();
+			}
+		});
+
+		// tally and update the manifest on this thread so the counters stay exact
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (std::size_t i = 0; i < groups.size(); i++) {
+			for (const auto& r : results[i])
+				count(r.first);
+			if (useManifest)
+				m_manifest[groups[i].front()->m_filename.string()] = results[i].back().second;
+		}
+
+		if (useManifest)
+			writeManifest();
+	}
+
+	void Filesystem::count(FlushResult result) {
+		switch (result) {
+			case FlushResult::Written:           newlywritten++; break;
+			case FlushResult::Overwritten:       overwritten++;  break;
+			case FlushResult::SkippedByManifest: skippedByManifest++; // fall through
+			case FlushResult::Skipped:           skipped++;      break;
+		}
+	}
+
+	void Filesystem::setStreaming(bool streaming) {
+		m_streaming = streaming;
+	}
+
+	void Filesystem::closeFile(File& file) {
+		Filesystem* target = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			file.m_closed = true;
+			target = m_target;
+		}
+		if (target) {
+			target->closeFile(file);
+			return;
+		}
+		if (!m_streaming)
+			return;
+
+		const auto useManifest = !m_manifestFile.empty();
+		const auto path = file.m_filename.string();
+
+		// the file is compared and written without holding the lock, so closing files on other threads is not blocked
+		ManifestEntry recorded;
+		bool hasRecorded = false;
+		std::time_t manifestTime = 0;
+		if (useManifest) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			manifestTime = m_manifestTime;
+			const auto it = m_manifest.find(path);
+			if (it != std::end(m_manifest)) {
+				recorded = it->second;
+				hasRecorded = true;
+			}
+		}
+
+		ManifestEntry entry;
+		const auto result = flushFile(file, hasRecorded ? &recorded : nullptr, manifestTime, useManifest ? &entry : nullptr);
+		file.m_stream.reset();
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		count(result);
+		if (useManifest)
+			m_manifest[path] = entry;
+	}
+
+	void Filesystem::streamInto(Filesystem& target) {
+		if (!target.m_streaming || m_streaming)
+			throw std::logic_error("Files can only be streamed from a buffering into a streaming Filesystem");
+
+		std::vector<File*> closed;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_target = &target;
+			for (auto& file : m_files)
+				if (file.m_closed && file.m_stream)
+					closed.push_back(&file);
+		}
+
+		// files closed from now on are flushed by the threads closing them
+		for (auto file : closed)
+			target.closeFile(*file);
+	}
+
+	void Filesystem::useManifest(boost::filesystem::path manifestFile) {
+		m_manifestFile = std::move(manifestFile);
+		m_manifest.clear();
+		readManifest();
+	}
+
+	auto Filesystem::isUnmodifiedSinceLastFlush(const boost::filesystem::path& path) const -> bool {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		const auto it = m_manifest.find(path.string());
+		return it != std::end(m_manifest) && matchesDisk(path, it->second.size, it->second.mtime, m_manifestTime);
+	}
+
+	void Filesystem::readManifest() {
+		std::ifstream f(m_manifestFile.string());
+		if (!f)
+			return;
+
+		// an unreadable manifest is ignored, all files are then compared by content
+		std::string line;
+		if (!std::getline(f, line) || line != c_manifestHeader)
+			return;
+
+		std::map<std::string, ManifestEntry> manifest;
+		while (std::getline(f, line)) {
+			// <hash> <size> <mtime> <path>
+			std::istringstream ss(line);
+			ManifestEntry entry;
+			ss >> std::hex >> entry.hash >> std::dec >> entry.size >> entry.mtime;
+			std::string path;
+			if (!ss || ss.get() != ' ' || !std::getline(ss, path) || path.empty())
+				return;
+			manifest[path] = entry;
+		}
+		m_manifest = std::move(manifest);
+
+		boost::system::error_code ec;
+		const auto manifestTime = boost::filesystem::last_write_time(m_manifestFile, ec);
+		m_manifestTime = ec ? 0 : manifestTime;
+	}
+
+	void Filesystem::writeManifest() {
+		std::ofstream f(m_manifestFile.string());
+		f.exceptions(std::ios::failbit | std::ios::badbit);
+		f << c_manifestHeader << '\n';
+		for (const auto& p : m_manifest)
+			f << std::hex << p.second.hash << std::dec << ' ' << p.second.size << ' ' << p.second.mtime << ' ' << p.first << '\n';
+		f.close();
+
+		// entries recorded in the same second as the manifest was written are not trusted from now on
+		boost::system::error_code ec;
+		const auto manifestTime = boost::filesystem::last_write_time(m_manifestFile, ec);
+		m_manifestTime = ec ? 0 : manifestTime;
 	}
 
 	auto Filesystem::newFile(boost::filesystem::path filename) -> File& {
+		// references to elements of a deque stay valid when new elements are appended
+		std::lock_guard<std::mutex> lock(m_mutex);
 		m_files.emplace_back(std::move(filename));
 		return m_files.back();
 	}
 
 	void Filesystem::removeIfExists(const boost::filesystem::path& path) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_manifest.erase(path.string());
+		m_removedPaths.push_back(path.string());
 		if (boost::filesystem::exists(path)) {
 			boost::filesystem::remove(path);
 			deleted++;
 		}
 	}
 
+	void Filesystem::takeFilesFrom(Filesystem& other) {
+		std::vector<File*> taken;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for (const auto& path : other.m_removedPaths)
+				m_manifest.erase(path);
+			m_removedPaths.insert(std::end(m_removedPaths), std::begin(other.m_removedPaths), std::end(other.m_removedPaths));
+			other.m_removedPaths.clear();
+
+			for (auto& file : other.m_files) {
+				m_files.push_back(std::move(file));
+				taken.push_back(&m_files.back());
+			}
+			other.m_files.clear();
+		}
+
+		for (auto file : taken)
+			if (file->m_stream)
+				closeFile(*file);
+
+		newlywritten      += other.newlywritten;
+		overwritten       += other.overwritten;
+		skipped           += other.skipped;
+		skippedByManifest += other.skippedByManifest;
+		deleted           += other.deleted;
+		other.newlywritten = other.overwritten = other.skipped = other.skippedByManifest = other.deleted = 0;
+	}
+
 	void Filesystem::mergeFilesInto(boost::filesystem::path filename) {
 		File f(std::move(filename));
+		mergeFilesInto(*f.m_stream);
+		m_files.push_back(std::move(f));
+	}
+
+	void Filesystem::mergeFilesInto(std::ostream& os) {
 		sortFiles();
 		for (auto& file : m_files) {
-			auto str = file.m_stream->str();
-			f.m_stream->write(str.c_str(), str.size());
+			if (!file.m_stream)
+				throw std::logic_error("Cannot merge file " + file.m_filename.string() + ", it has already been flushed");
+
+			// copy via the stream buffer, str() would create another copy of the content
+			if (file.m_stream->tellp() > 0)
+				os << file.m_stream->rdbuf();
+			file.m_stream.reset();
 		}
 		m_files.clear();
-		m_files.push_back(std::move(f));
 	}
 
 	void Filesystem::sortFiles() {
@@ -2,10 +2,15 @@
 
 #include <boost/optional.hpp>
 #include <boost/filesystem.hpp>
+#include <cstdint>
+#include <ctime>
 #include <string>
 #include <sstream>
+#include <map>
 #include <memory>
 #include <deque>
+#include <mutex>
+#include <vector>
 
 namespace tigl {
     auto readFile(const boost::filesystem::path& filename) -> std::string;
@@ -26,29 +31,87 @@ namespace tigl {
     private:
         friend class Filesystem;
 
-        std::unique_ptr<std::ostringstream> m_stream; // workaround for GCC < 5.0, where stringstream is not moveable ..
+        std::unique_ptr<std::stringstream> m_stream; // workaround for GCC < 5.0, where stringstream is not moveable .., readable for streaming it into other streams
         boost::filesystem::path m_filename;
+        bool m_closed = false;
     };
 
     class Filesystem {
     public:
         Filesystem() = default;
 
+        // newFile, closeFile and removeIfExists may be called concurrently, the returned File stays valid until the Filesystem is destroyed
         auto newFile(boost::filesystem::path filename) -> File&;
         void removeIfExists(const boost::filesystem::path& path);
 
+        // appends the files of other as if they had been created here and takes over its removals and counters.
+        // Allows generating into separate Filesystems concurrently and combining them in a deterministic order.
+        // In streaming mode, the taken files are flushed immediately
+        void takeFilesFrom(Filesystem& other);
+
+        // in streaming mode, files are flushed as soon as they are closed and their content is released.
+        // Only the files currently being generated are then held in memory
+        void setStreaming(bool streaming);
+
+        // marks the content of file as complete. In streaming mode, file is flushed immediately and must not be written to anymore
+        void closeFile(File& file);
+
+        // flushes the files closed so far through target, which must be in streaming mode while this one is not, and forwards all files closed afterwards to it.
+        // Allows a Filesystem generated into separately to stream its files once all Filesystems taken over before it have been flushed.
+        // takeFilesFrom still has to be called for the remaining files, removals and counters
+        void streamInto(Filesystem& target);
+
         void mergeFilesInto(boost::filesystem::path filename);
 
-        void flushToDisk();
+        // writes the content of all files to os, releasing each file after it has been written.
+        // Unlike mergeFilesInto, the merged content is never held in memory as a whole
+        void mergeFilesInto(std::ostream& os);
+
+        // records hash, size and modification time of all flushed files in the given manifest file.
+        // files whose new content matches an entry still valid on disk are then skipped without being read
+        void useManifest(boost::filesystem::path manifestFile);
+
+        // true if the manifest recorded path during an earlier flush and the file has not been modified since
+        auto isUnmodifiedSinceLastFlush(const boost::filesystem::path& path) const -> bool;
+
+        // compares and writes all files not flushed yet on up to jobs threads, 0 uses one thread per core.
+        // The content of flushed files is released, so flushToDisk can be called repeatedly while files are added
+        void flushToDisk(unsigned int jobs = 1);
 
         std::size_t newlywritten = 0;
         std::size_t overwritten = 0;
         std::size_t skipped = 0;
+        std::size_t skippedByManifest = 0; // subset of skipped
         std::size_t deleted = 0;
 
     private:
+        enum class FlushResult {
+            Written,
+            Overwritten,
+            Skipped,
+            SkippedByManifest
+        };
+
+        struct ManifestEntry {
+            std::uint64_t hash = 0;
+            std::uintmax_t size = 0;
+            std::time_t mtime = 0;
+        };
+
+        static auto flushFile(const File& file, const ManifestEntry* recorded, std::time_t manifestTime, ManifestEntry* entry) -> FlushResult;
+        void count(FlushResult result);
+        void readManifest();
+        void writeManifest(); // requires m_mutex
         void sortFiles();
 
+        mutable std::mutex m_mutex;
         std::deque<File> m_files;
+        std::vector<std::string> m_removedPaths;
+        bool m_streaming = false;
+        Filesystem* m_target = nullptr; // see streamInto
+
+        boost::filesystem::path m_manifestFile;
+        std::map<std::string, ManifestEntry> m_manifest;
+        std::time_t m_manifestTime = 0; // last write time of the manifest file, only entries recorded before it are trusted
     };
 }
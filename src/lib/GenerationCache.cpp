@@ -0,0 +1,101 @@
+#include "GenerationCache.h"
+
+#include <fstream>
+#include <sstream>
+
+#include "Filesystem.h"
+
+namespace tigl {
+    namespace {
+        const auto c_cacheHeader = std::string("CPACSGen cache 1");
+    }
+
+    auto GenerationCache::Pass::reuse(const boost::filesystem::path& file, std::uint64_t fingerprint) -> bool {
+        if (!m_previous)
+            return false;
+        const auto it = m_previous->files.find(file.string());
+        if (it == std::end(m_previous->files) || it->second != fingerprint || !m_cache.m_fs.isUnmodifiedSinceLastFlush(file))
+            return false;
+        record(file, fingerprint);
+        std::lock_guard<std::mutex> lock(m_cache.m_mutex);
+        m_cache.reusedFiles++;
+        return true;
+    }
+
+    void GenerationCache::Pass::record(const boost::filesystem::path& file, std::uint64_t fingerprint) {
+        m_current.files[file.string()] = fingerprint;
+    }
+
+    GenerationCache::GenerationCache(boost::filesystem::path cacheFile, std::uint64_t generatorFingerprint, const Filesystem& fs)
+        : m_cacheFile(std::move(cacheFile)), m_generatorFingerprint(generatorFingerprint), m_fs(fs) {
+        read(generatorFingerprint);
+    }
+
+    auto GenerationCache::reusePass(const std::string& name, std::uint64_t inputFingerprint) -> bool {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto it = m_previous.find(name);
+        if (it == std::end(m_previous) || it->second.inputFingerprint != inputFingerprint)
+            return false;
+        for (const auto& p : it->second.files)
+            if (!m_fs.isUnmodifiedSinceLastFlush(p.first))
+                return false;
+        m_current[name] = it->second;
+        reusedPasses++;
+        return true;
+    }
+
+    auto GenerationCache::beginPass(const std::string& name, std::uint64_t inputFingerprint) -> Pass {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& current = m_current[name];
+        current = PassRecord{};
+        current.inputFingerprint = inputFingerprint;
+
+        const auto it = m_previous.find(name);
+        return Pass(*this, it != std::end(m_previous) ? &it->second : nullptr, current);
+    }
+
+    void GenerationCache::read(std::uint64_t generatorFingerprint) {
+        std::ifstream f(m_cacheFile.string());
+        if (!f)
+            return;
+
+        // a cache from a different generator build or an unreadable cache is ignored, everything is then generated again
+        std::string line;
+        std::ostringstream header;
+        header << c_cacheHeader << ' ' << std::hex << generatorFingerprint;
+        if (!std::getline(f, line) || line != header.str())
+            return;
+
+        // pass\t<name>\t<input fingerprint>
+        // file\t<fingerprint>\t<path>
+        std::map<std::string, PassRecord> passes;
+        PassRecord* pass = nullptr;
+        while (std::getline(f, line)) {
+            std::istringstream ss(line);
+            std::string kind, first, second;
+            if (!std::getline(ss, kind, '\t') || !std::getline(ss, first, '\t') || !std::getline(ss, second) || second.empty())
+                return;
+            if (kind == "pass") {
+                pass = &passes[first];
+                pass->inputFingerprint = std::stoull(second, nullptr, 16);
+            } else if (kind == "file" && pass)
+                pass->files[second] = std::stoull(first, nullptr, 16);
+            else
+                return;
+        }
+        m_previous = std::move(passes);
+    }
+
+    void GenerationCache::save() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::ofstream f(m_cacheFile.string());
+        f.exceptions(std::ios::failbit | std::ios::badbit);
+        f << c_cacheHeader << ' ' << std::hex << m_generatorFingerprint << '\n';
+        for (const auto& p : m_current) {
+            f << "pass\t" << p.first << '\t' << p.second.inputFingerprint << '\n';
+            for (const auto& file : p.second.files)
+                f << "file\t" << file.second << '\t' << file.first << '\n';
+        }
+        f.close();
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <boost/filesystem.hpp>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace tigl {
+    class Filesystem;
+
+    // Persistent record of the input fingerprints the generated files were produced from.
+    // Allows skipping whole passes (parsing, building and generating) whose inputs did not change,
+    // and skipping the generation of single classes and enums whose inputs did not change.
+    // Generated files are only reused if they are unmodified on disk according to the Filesystem's manifest.
+    // Passes may be begun and run concurrently, a single Pass must only be used by one thread at a time
+    class GenerationCache {
+        struct PassRecord {
+            std::uint64_t inputFingerprint = 0;
+            std::map<std::string, std::uint64_t> files; // path -> fingerprint
+        };
+
+    public:
+        class Pass {
+        public:
+            // true if file was generated by this pass from the same fingerprint before and is unmodified.
+            // A reused file is recorded again and must not be regenerated
+            auto reuse(const boost::filesystem::path& file, std::uint64_t fingerprint) -> bool;
+
+            // records that file has been generated from fingerprint
+            void record(const boost::filesystem::path& file, std::uint64_t fingerprint);
+
+        private:
+            friend class GenerationCache;
+
+            Pass(GenerationCache& cache, const PassRecord* previous, PassRecord& current)
+                : m_cache(cache), m_previous(previous), m_current(current) {}
+
+            GenerationCache& m_cache;
+            const PassRecord* m_previous;
+            PassRecord& m_current;
+        };
+
+        // generatorFingerprint identifies the generator build, a cache written by a different build is discarded
+        GenerationCache(boost::filesystem::path cacheFile, std::uint64_t generatorFingerprint, const Filesystem& fs);
+
+        // true if the pass ran before with the same input fingerprint and all its files are unmodified.
+        // The pass is then kept as it is and does not need to run again
+        auto reusePass(const std::string& name, std::uint64_t inputFingerprint) -> bool;
+
+        // starts recording a pass which runs again. Files it does not record are forgotten
+        auto beginPass(const std::string& name, std::uint64_t inputFingerprint) -> Pass;
+
+        // writes all reused and begun passes, passes neither reused nor begun are forgotten
+        void save() const;
+
+        std::size_t reusedPasses = 0;
+        std::size_t reusedFiles = 0;
+
+    private:
+        void read(std::uint64_t generatorFingerprint);
+
+        boost::filesystem::path m_cacheFile;
+        std::uint64_t m_generatorFingerprint;
+        const Filesystem& m_fs;
+
+        mutable std::mutex m_mutex;
+        std::map<std::string, PassRecord> m_previous;
+        std::map<std::string, PassRecord> m_current;
+    };
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace tigl {
+    // 64 bit FNV-1a. Unlike std::hash, the result is stable across platforms, compilers and runs and can be persisted
+    constexpr std::uint64_t c_fnv1aOffsetBasis = 14695981039346656037ull;
+
+    inline auto fnv1a(const char* data, std::size_t size, std::uint64_t hash = c_fnv1aOffsetBasis) -> std::uint64_t {
+        for (std::size_t i = 0; i < size; i++) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    inline auto fnv1a(const std::string& str, std::uint64_t hash = c_fnv1aOffsetBasis) -> std::uint64_t {
+        return fnv1a(str.data(), str.size(), hash);
+    }
+
+    // incrementally hashes a sequence of values. Strings are length prefixed, so ("ab", "c") and ("a", "bc") hash differently
+    class Hasher {
+    public:
+        auto operator<<(const std::string& str) -> Hasher& {
+            *this << str.size();
+            m_hash = fnv1a(str, m_hash);
+            return *this;
+        }
+
+        auto operator<<(const char* str) -> Hasher& {
+            return *this << std::string(str);
+        }
+
+        template <typename T, typename = typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type>
+        auto operator<<(T value) -> Hasher& {
+            const auto v = static_cast<std::uint64_t>(value);
+            for (unsigned int i = 0; i < sizeof(v); i++) {
+                const auto byte = static_cast<char>((v >> (8 * i)) & 0xFF);
+                m_hash = fnv1a(&byte, 1, m_hash);
+            }
+            return *this;
+        }
+
+        auto value() const -> std::uint64_t {
+            return m_hash;
+        }
+
+    private:
+        std::uint64_t m_hash = c_fnv1aOffsetBasis;
+    };
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+
+namespace tigl {
+    // escapes str for use inside a JSON string literal
+    inline auto escapeJson(const std::string& str) -> std::string {
+        std::string result;
+        result.reserve(str.size());
+        for (const auto c : str) {
+            switch (c) {
+                case '"':  result += "\\\""; break;
+                case '\\': result += "\\\\"; break;
+                case '\n': result += "\\n";  break;
+                case '\t': result += "\\t";  break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        static const char hex[] = "0123456789abcdef";
+                        result += "\\u00";
+                        result += hex[(c >> 4) & 0xf];
+                        result += hex[c & 0xf];
+                    } else
+                        result += c;
+            }
+        }
+        return result;
+    }
+}
@@ -0,0 +1,96 @@
+#include "Logging.h"
+
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+#include "Json.h"
+
+namespace tigl {
+    namespace {
+        // pending console output is written once it exceeds this size
+        const std::size_t c_consoleBufferSize = 64 * 1024;
+
+        auto levelName(LogLevel level) -> const char* {
+            switch (level) {
+                case LogLevel::Error:   return "error";
+                case LogLevel::Warning: return "warning";
+                case LogLevel::Info:    return "info";
+                case LogLevel::Debug:   return "debug";
+            }
+            throw std::logic_error("Invalid log level");
+        }
+    }
+
+    auto Logger::instance() -> Logger& {
+        static Logger logger;
+        return logger;
+    }
+
+    Logger::Logger()
+        : m_start(std::chrono::steady_clock::now()) {
+        m_console.reserve(c_consoleBufferSize);
+    }
+
+    Logger::~Logger() {
+        flush();
+    }
+
+    void Logger::setConsoleLevel(LogLevel level) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_consoleLevel = level;
+    }
+
+    void Logger::openFile(const std::string& filename, LogLevel level) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fileOpen = false;
+        m_file.close();
+        m_file.open(filename);
+        if (!m_file)
+            throw std::runtime_error("Failed to open file " + filename + " for writing");
+        m_file << std::fixed << std::setprecision(6);
+        m_fileLevel = level;
+        m_fileOpen = true;
+    }
+
+    void Logger::closeFile() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fileOpen = false;
+        m_file.close();
+    }
+
+    void Logger::write(LogLevel level, const std::string& message) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (level <= m_consoleLevel) {
+            if (level <= LogLevel::Warning) {
+                // keep the order with the pending messages
+                flushConsole();
+                std::cerr << (level == LogLevel::Error ? "Error: " : "Warning: ") << message << std::endl;
+            } else {
+                m_console += message;
+                m_console += '\n';
+                if (m_console.size() >= c_consoleBufferSize)
+                    flushConsole();
+            }
+        }
+        if (m_file.is_open() && level <= m_fileLevel) {
+            const auto time = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+            m_file << "{ \"time\": " << time << ", \"level\": \"" << levelName(level) << "\", \"message\": \"" << escapeJson(message) << "\" }\n";
+        }
+    }
+
+    void Logger::flush() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        flushConsole();
+        if (m_file.is_open())
+            m_file.flush();
+    }
+
+    void Logger::flushConsole() {
+        if (m_console.empty())
+            return;
+        std::cout.write(m_console.data(), static_cast<std::streamsize>(m_console.size()));
+        std::cout.flush();
+        m_console.clear();
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+
+namespace tigl {
+    enum class LogLevel {
+        Error,
+        Warning,
+        Info,  // progress of the generator and summaries
+        Debug  // every decision, e.g. table entries, pruned types and renamed enums
+    };
+
+    // Writes log messages to the console and optionally to a log file with one JSON object per line.
+    // Console output is buffered and only flushed when full, on warnings and errors, and by flush.
+    // May be used from multiple threads
+    class Logger {
+    public:
+        static auto instance() -> Logger&;
+
+        ~Logger();
+
+        // messages above level are not written to the console. Defaults to Info
+        void setConsoleLevel(LogLevel level);
+
+        // additionally writes all messages up to level to filename
+        void openFile(const std::string& filename, LogLevel level = LogLevel::Debug);
+        void closeFile();
+
+        // may be called without synchronization, e.g. by LogLine on any thread
+        auto enabled(LogLevel level) const -> bool {
+            return level <= m_consoleLevel.load(std::memory_order_relaxed) || (m_fileOpen.load(std::memory_order_relaxed) && level <= m_fileLevel.load(std::memory_order_relaxed));
+        }
+
+        void write(LogLevel level, const std::string& message);
+
+        void flush();
+
+    private:
+        Logger();
+
+        void flushConsole();
+
+        // written under m_mutex, read by enabled without it
+        std::atomic<LogLevel> m_consoleLevel{ LogLevel::Info };
+        std::atomic<LogLevel> m_fileLevel{ LogLevel::Debug };
+        std::atomic<bool> m_fileOpen{ false };
+        std::chrono::steady_clock::time_point m_start;
+
+        std::mutex m_mutex;
+        std::string m_console; // pending info and debug messages
+        std::ofstream m_file;
+    };
+
+    // collects one message and writes it to the Logger on destruction. Formats nothing if the level is disabled
+    class LogLine {
+    public:
+        explicit LogLine(LogLevel level)
+            : m_level(level) {
+            if (Logger::instance().enabled(level))
+                m_stream.reset(new std::ostringstream); // workaround for GCC < 5.0, where ostringstream is not moveable
+        }
+
+        LogLine(LogLine&&) = default;
+
+        ~LogLine() {
+            if (m_stream)
+                Logger::instance().write(m_level, m_stream->str());
+        }
+
+        template <typename T>
+        auto operator<<(T&& t) -> LogLine& {
+            if (m_stream)
+                *m_stream << std::forward<T>(t);
+            return *this;
+        }
+
+    private:
+        LogLevel m_level;
+        std::unique_ptr<std::ostringstream> m_stream;
+    };
+
+    inline auto log(LogLevel level) -> LogLine {
+        return LogLine(level);
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tigl {
+    // a job count of 0 requests one job per hardware thread
+    inline auto effectiveJobCount(unsigned int jobs) -> unsigned int {
+        if (jobs == 0)
+            jobs = std::max(1u, std::thread::hardware_concurrency());
+        return jobs;
+    }
+
+    // calls func(i) for every i in [0, count) using at most jobs threads, including the calling thread.
+    // the first exception thrown by func is rethrown on the calling thread after all workers have finished
+    template <typename Func>
+    void parallelFor(std::size_t count, unsigned int jobs, Func func) {
+        jobs = static_cast<unsigned int>(std::min<std::size_t>(effectiveJobCount(jobs), count));
+        if (jobs <= 1) {
+            for (std::size_t i = 0; i < count; i++)
+                func(i);
+            return;
+        }
+
+        std::atomic<std::size_t> next{0};
+        std::exception_ptr error;
+        std::mutex errorMutex;
+
+        auto worker = [&] {
+            for (auto i = next++; i < count; i = next++) {
+                try {
+                    func(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error)
+                        error = std::current_exception();
+                    next = count; // stop handing out further work
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(jobs - 1);
+        for (unsigned int i = 1; i < jobs; i++)
+            threads.emplace_back(worker);
+        worker();
+        for (auto& t : threads)
+            t.join();
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
@@ -0,0 +1,299 @@
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace tigl {
+    // queue between two pipeline stages. push blocks while the queue is full, pop blocks while it is empty
+    template <typename T>
+    class BoundedQueue {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit BoundedQueue(std::size_t capacity)
+            : m_capacity(std::max<std::size_t>(1, capacity)) {}
+
+        // returns false if the queue has been aborted. waited receives the time spent blocked on a full queue
+        auto push(T value, Clock::duration& waited) -> bool {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            const auto start = Clock::now();
+            m_notFull.wait(lock, [&] { return m_aborted || m_items.size() < m_capacity; });
+            waited += Clock::now() - start;
+            if (m_aborted)
+                return false;
+            m_items.push_back(std::move(value));
+            m_maxDepth = std::max(m_maxDepth, m_items.size());
+            m_notEmpty.notify_one();
+            return true;
+        }
+
+        // returns none if the queue has been closed and is empty, or has been aborted. waited receives the time spent blocked on an empty queue
+        auto pop(Clock::duration& waited) -> boost::optional<T> {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            const auto start = Clock::now();
+            m_notEmpty.wait(lock, [&] { return m_aborted || m_closed || !m_items.empty(); });
+            waited += Clock::now() - start;
+            if (m_aborted || m_items.empty())
+                return boost::none;
+            auto value = std::move(m_items.front());
+            m_items.pop_front();
+            m_notFull.notify_one();
+            return value;
+        }
+
+        // no more items will be pushed
+        void close() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+            m_notEmpty.notify_all();
+        }
+
+        // wakes all waiting threads and drops all items
+        void abort() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_aborted = true;
+            m_items.clear();
+            m_notEmpty.notify_all();
+            m_notFull.notify_all();
+        }
+
+        auto maxDepth() const -> std::size_t {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_maxDepth;
+        }
+
+    private:
+        const std::size_t m_capacity;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_notEmpty;
+        std::condition_variable m_notFull;
+        std::deque<T> m_items;
+        std::size_t m_maxDepth = 0;
+        bool m_closed = false;
+        bool m_aborted = false;
+    };
+
+    struct StageStats {
+        std::string name;
+        unsigned int workers = 1;
+        std::size_t items = 0;
+        std::size_t maxQueueDepth = 0;   // of the queue in front of the stage
+        double busySeconds = 0;          // summed over the stage's workers
+        double inputStallSeconds = 0;    // waiting for the previous stage or for a free job
+        double outputStallSeconds = 0;   // waiting for the items before to be handed on and for the next stage to make room
+    };
+
+    // passes items through a sequence of stages. Each stage runs on its own worker threads and hands its items to the next stage
+    // through a bounded queue, so different items are processed by different stages at the same time.
+    // A stage with multiple workers processes multiple items at the same time, but hands them on in order,
+    // so items pass every stage in the order they were given
+    template <typename T>
+    class Pipeline {
+        using Clock = typename BoundedQueue<T>::Clock;
+
+    public:
+        explicit Pipeline(std::size_t queueCapacity)
+            : m_queueCapacity(queueCapacity) {}
+
+        void addStage(std::string name, std::function<void(T&)> func, unsigned int workers = 1) {
+            m_stages.push_back(Stage{ std::move(func), std::max(1u, workers) });
+            m_stats.emplace_back();
+            m_stats.back().name = std::move(name);
+            m_stats.back().workers = m_stages.back().workers;
+        }
+
+        // runs all items through all stages, calling the stage functions on at most jobs threads at the same time.
+        // With a single job, every item runs through all stages before the next one starts.
+        // The first exception thrown by a stage is rethrown after all stages have stopped
+        void run(std::vector<T> items, unsigned int jobs) {
+            if (jobs <= 1 || items.size() < 2) {
+                for (auto& item : items) {
+                    for (std::size_t s = 0; s < m_stages.size(); s++) {
+                        const auto start = Clock::now();
+                        m_stages[s].func(item);
+                        m_stats[s].busySeconds += seconds(Clock::now() - start);
+                        m_stats[s].items++;
+                    }
+                }
+                return;
+            }
+
+            // queues[s] is in front of stage s
+            std::vector<std::unique_ptr<BoundedQueue<Sequenced>>> queues;
+            for (std::size_t s = 0; s < m_stages.size(); s++)
+                queues.emplace_back(new BoundedQueue<Sequenced>(m_queueCapacity));
+
+            // shared by the workers of a stage
+            struct StageState {
+                std::mutex mutex;
+                std::condition_variable handedOn;
+                std::size_t nextOut = 0; // sequence number of the next item to hand on
+                unsigned int running = 0;
+            };
+            std::vector<std::unique_ptr<StageState>> stageStates;
+            for (const auto& stage : m_stages) {
+                stageStates.emplace_back(new StageState);
+                stageStates.back()->running = stage.workers;
+            }
+
+            Jobs freeJobs(jobs);
+            std::exception_ptr error;
+            std::mutex errorMutex;
+            std::atomic<bool> aborted{ false };
+            auto abortAll = [&] {
+                aborted = true;
+                for (auto& q : queues)
+                    q->abort();
+                for (auto& st : stageStates) {
+                    std::lock_guard<std::mutex> lock(st->mutex);
+                    st->handedOn.notify_all();
+                }
+            };
+
+            auto worker = [&](std::size_t s) {
+                auto& state = *stageStates[s];
+                typename Clock::duration inputStall{}, outputStall{}, busy{};
+                std::size_t items = 0;
+                try {
+                    while (auto item = queues[s]->pop(inputStall)) {
+                        {
+                            Job job(freeJobs, inputStall);
+                            const auto start = Clock::now();
+                            m_stages[s].func(item->value);
+                            busy += Clock::now() - start;
+                        }
+                        items++;
+
+                        // hand on in order, the items before may still be processed by other workers of this stage
+                        const auto start = Clock::now();
+                        std::unique_lock<std::mutex> lock(state.mutex);
+                        state.handedOn.wait(lock, [&] { return aborted || state.nextOut == item->sequence; });
+                        outputStall += Clock::now() - start;
+                        if (aborted || (s + 1 < m_stages.size() && !queues[s + 1]->push(std::move(*item), outputStall)))
+                            break;
+                        state.nextOut++;
+                        state.handedOn.notify_all();
+                    }
+                } catch (...) {
+                    {
+                        std::lock_guard<std::mutex> lock(errorMutex);
+                        if (!error)
+                            error = std::current_exception();
+                    }
+                    abortAll();
+                }
+
+                std::lock_guard<std::mutex> lock(state.mutex);
+                auto& stats = m_stats[s];
+                stats.items += items;
+                stats.busySeconds += seconds(busy);
+                stats.inputStallSeconds += seconds(inputStall);
+                stats.outputStallSeconds += seconds(outputStall);
+                if (--state.running == 0 && s + 1 < m_stages.size())
+                    queues[s + 1]->close();
+            };
+
+            std::vector<std::thread> threads;
+            for (std::size_t s = 0; s < m_stages.size(); s++)
+                for (unsigned int w = 0; w < m_stages[s].workers; w++)
+                    threads.emplace_back(worker, s);
+
+            // feed the first stage from this thread
+            typename Clock::duration feedStall{};
+            for (std::size_t i = 0; i < items.size(); i++)
+                if (!queues.front()->push(Sequenced{ i, std::move(items[i]) }, feedStall))
+                    break;
+            queues.front()->close();
+
+            for (auto& t : threads)
+                t.join();
+            for (std::size_t s = 0; s < m_stages.size(); s++)
+                m_stats[s].maxQueueDepth = std::max(m_stats[s].maxQueueDepth, queues[s]->maxDepth());
+
+            if (error)
+                std::rethrow_exception(error);
+        }
+
+        auto stats() const -> const std::vector<StageStats>& {
+            return m_stats;
+        }
+
+    private:
+        struct Stage {
+            std::function<void(T&)> func;
+            unsigned int workers;
+        };
+
+        // limits the number of stage functions running at the same time
+        class Jobs {
+        public:
+            explicit Jobs(unsigned int count)
+                : m_free(count) {}
+
+            void acquire() {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_freed.wait(lock, [&] { return m_free > 0; });
+                m_free--;
+            }
+
+            void release() {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_free++;
+                m_freed.notify_one();
+            }
+
+        private:
+            std::mutex m_mutex;
+            std::condition_variable m_freed;
+            unsigned int m_free;
+        };
+
+        // holds one of the jobs while a stage function runs, waited receives the time spent waiting for it
+        class Job {
+        public:
+            Job(Jobs& jobs, typename Clock::duration& waited)
+                : m_jobs(jobs) {
+                const auto start = Clock::now();
+                m_jobs.acquire();
+                waited += Clock::now() - start;
+            }
+
+            Job(const Job&) = delete;
+            Job& operator=(const Job&) = delete;
+
+            ~Job() {
+                m_jobs.release();
+            }
+
+        private:
+            Jobs& m_jobs;
+        };
+
+        // an item with its position in the input, by which the workers of a stage hand items on in order
+        struct Sequenced {
+            std::size_t sequence;
+            T value;
+        };
+
+        static auto seconds(typename Clock::duration d) -> double {
+            return std::chrono::duration<double>(d).count();
+        }
+
+        std::size_t m_queueCapacity;
+        std::vector<Stage> m_stages;
+        std::vector<StageStats> m_stats;
+    };
+}
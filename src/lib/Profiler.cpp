@@ -0,0 +1,200 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+#include "Json.h"
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #ifndef PSAPI_VERSION
+        #define PSAPI_VERSION 2 // GetProcessMemoryInfo from kernel32, no psapi.lib needed
+    #endif
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+namespace tigl {
+    namespace {
+        thread_local ProfilePhase* currentPhase = nullptr;
+
+        auto processCpuSeconds() -> double {
+#ifdef _WIN32
+            FILETIME creation, exit, kernel, user;
+            if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+                return 0;
+            auto toSeconds = [](const FILETIME& t) {
+                return ((static_cast<std::uint64_t>(t.dwHighDateTime) << 32) | t.dwLowDateTime) * 1e-7;
+            };
+            return toSeconds(kernel) + toSeconds(user);
+#else
+            rusage usage;
+            if (getrusage(RUSAGE_SELF, &usage) != 0)
+                return 0;
+            auto toSeconds = [](const timeval& t) {
+                return t.tv_sec + t.tv_usec * 1e-6;
+            };
+            return toSeconds(usage.ru_utime) + toSeconds(usage.ru_stime);
+#endif
+        }
+
+        auto peakRssBytes() -> std::uint64_t {
+#ifdef _WIN32
+            PROCESS_MEMORY_COUNTERS counters;
+            if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+                return 0;
+            return counters.PeakWorkingSetSize;
+#else
+            rusage usage;
+            if (getrusage(RUSAGE_SELF, &usage) != 0)
+                return 0;
+    #ifdef __APPLE__
+            return static_cast<std::uint64_t>(usage.ru_maxrss);
+    #else
+            return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+    #endif
+#endif
+        }
+
+        auto openForWriting(const std::string& filename) -> std::ofstream {
+            std::ofstream f(filename);
+            if (!f)
+                throw std::runtime_error("Failed to open file " + filename + " for writing");
+            f << std::fixed << std::setprecision(6);
+            return f;
+        }
+    }
+
+    auto Profiler::instance() -> Profiler& {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    void Profiler::enable(const std::atomic<std::uint64_t>* allocations) {
+        m_allocations = allocations;
+        m_start = Clock::now();
+        m_enabled = true;
+    }
+
+    auto Profiler::records() const -> std::vector<PhaseRecord> {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_records;
+    }
+
+    void Profiler::writeJson(const std::string& filename) const {
+        struct Total {
+            std::size_t count = 0;
+            double wallSeconds = 0;
+            double cpuSeconds = 0;
+            std::uint64_t allocations = 0;
+        };
+
+        const auto records = this->records();
+        std::map<std::string, Total> totals;
+        std::uint64_t peakRss = 0;
+        for (const auto& r : records) {
+            auto& t = totals[r.name];
+            t.count++;
+            t.wallSeconds += r.wallSeconds;
+            t.cpuSeconds += r.cpuSeconds;
+            t.allocations += r.allocations;
+            peakRss = std::max(peakRss, r.peakRss);
+        }
+
+        auto f = openForWriting(filename);
+        f << "{\n";
+        f << "  \"peakRss\": " << peakRss << ",\n";
+        f << "  \"phases\": [";
+        for (std::size_t i = 0; i < records.size(); i++) {
+            const auto& r = records[i];
+            f << (i == 0 ? "\n" : ",\n")
+                << "    { \"name\": \"" << escapeJson(r.name) << "\", \"pass\": \"" << escapeJson(r.pass) << "\""
+                << ", \"thread\": " << r.thread << ", \"depth\": " << r.depth
+                << ", \"start\": " << r.startSeconds << ", \"wall\": " << r.wallSeconds << ", \"cpu\": " << r.cpuSeconds
+                << ", \"peakRss\": " << r.peakRss << ", \"allocations\": " << r.allocations << " }";
+        }
+        f << "\n  ],\n";
+        f << "  \"totals\": [";
+        bool first = true;
+        for (const auto& p : totals) {
+            const auto& t = p.second;
+            f << (first ? "\n" : ",\n")
+                << "    { \"name\": \"" << escapeJson(p.first) << "\", \"count\": " << t.count
+                << ", \"wall\": " << t.wallSeconds << ", \"cpu\": " << t.cpuSeconds << ", \"allocations\": " << t.allocations << " }";
+            first = false;
+        }
+        f << "\n  ]\n";
+        f << "}\n";
+    }
+
+    void Profiler::writeChromeTrace(const std::string& filename) const {
+        const auto records = this->records();
+
+        auto f = openForWriting(filename);
+        f << "{\n";
+        f << "  \"displayTimeUnit\": \"ms\",\n";
+        f << "  \"traceEvents\": [";
+        for (std::size_t i = 0; i < records.size(); i++) {
+            const auto& r = records[i];
+            const auto label = r.pass.empty() ? r.name : r.name + " " + r.pass;
+            f << (i == 0 ? "\n" : ",\n")
+                << "    { \"name\": \"" << escapeJson(label) << "\", \"cat\": \"" << escapeJson(r.name) << "\", \"ph\": \"X\""
+                << ", \"ts\": " << r.startSeconds * 1e6 << ", \"dur\": " << r.wallSeconds * 1e6 << ", \"pid\": 1, \"tid\": " << r.thread
+                << ", \"args\": { \"pass\": \"" << escapeJson(r.pass) << "\", \"cpu\": " << r.cpuSeconds
+                << ", \"peakRss\": " << r.peakRss << ", \"allocations\": " << r.allocations << " } }";
+        }
+        f << "\n  ]\n";
+        f << "}\n";
+    }
+
+    auto Profiler::sample() const -> Sample {
+        return Sample{ Clock::now(), processCpuSeconds(), m_allocations ? m_allocations->load(std::memory_order_relaxed) : 0 };
+    }
+
+    auto Profiler::threadIndex(std::thread::id id) -> std::size_t {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_threads.emplace(id, m_threads.size()).first->second;
+    }
+
+    void Profiler::add(PhaseRecord record) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_records.push_back(std::move(record));
+    }
+
+    ProfilePhase::ProfilePhase(const char* name, std::string pass)
+        : m_active(Profiler::instance().enabled()), m_parent(currentPhase) {
+        if (!m_active)
+            return;
+
+        auto& profiler = Profiler::instance();
+        m_record.name = name;
+        m_record.pass = std::move(pass);
+        if (m_record.pass.empty() && m_parent)
+            m_record.pass = m_parent->m_record.pass;
+        m_record.thread = profiler.threadIndex(std::this_thread::get_id());
+        m_record.depth = m_parent ? m_parent->m_record.depth + 1 : 0;
+        currentPhase = this;
+        m_begin = profiler.sample();
+    }
+
+    ProfilePhase::~ProfilePhase() {
+        if (!m_active)
+            return;
+
+        auto& profiler = Profiler::instance();
+        const auto end = profiler.sample();
+        m_record.startSeconds = std::chrono::duration<double>(m_begin.wall - profiler.m_start).count();
+        m_record.wallSeconds = std::chrono::duration<double>(end.wall - m_begin.wall).count();
+        m_record.cpuSeconds = end.cpuSeconds - m_begin.cpuSeconds;
+        m_record.allocations = end.allocations - m_begin.allocations;
+        m_record.peakRss = peakRssBytes();
+        currentPhase = m_parent;
+        profiler.add(std::move(m_record));
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tigl {
+    // a finished phase. CPU time, peak RSS and allocations are measured for the whole process,
+    // so phases running at the same time on different threads (e.g. pipeline stages) include each other
+    struct PhaseRecord {
+        std::string name;
+        std::string pass;          // schema pass the phase ran for, empty outside of a pass
+        std::size_t thread = 0;    // index of the thread in the order threads first ran a phase
+        std::size_t depth = 0;     // number of enclosing phases on the same thread
+        double startSeconds = 0;   // since the profiler was enabled
+        double wallSeconds = 0;
+        double cpuSeconds = 0;
+        std::uint64_t peakRss = 0; // high-water mark of the resident set at the end of the phase, in bytes
+        std::uint64_t allocations = 0;
+    };
+
+    // Records the phases of a generator run. Disabled by default, phases cost a single check then
+    class Profiler {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static auto instance() -> Profiler&;
+
+        // allocations is incremented by the executable's operator new, if it replaces it.
+        // Without it, no allocations are reported
+        void enable(const std::atomic<std::uint64_t>* allocations = nullptr);
+
+        auto enabled() const -> bool {
+            return m_enabled;
+        }
+
+        auto records() const -> std::vector<PhaseRecord>;
+
+        // per phase records and totals per phase name
+        void writeJson(const std::string& filename) const;
+
+        // trace event format, may be opened in chrome://tracing or ui.perfetto.dev
+        void writeChromeTrace(const std::string& filename) const;
+
+    private:
+        friend class ProfilePhase;
+
+        struct Sample {
+            Clock::time_point wall;
+            double cpuSeconds;
+            std::uint64_t allocations;
+        };
+
+        auto sample() const -> Sample;
+        auto threadIndex(std::thread::id id) -> std::size_t;
+        void add(PhaseRecord record);
+
+        bool m_enabled = false;
+        const std::atomic<std::uint64_t>* m_allocations = nullptr;
+        Clock::time_point m_start;
+
+        mutable std::mutex m_mutex;
+        std::vector<PhaseRecord> m_records;
+        std::map<std::thread::id, std::size_t> m_threads;
+    };
+
+    // Profiles the enclosing scope as a phase of the generator.
+    // Nested phases without a pass inherit the pass of the enclosing phase on the same thread
+    class ProfilePhase {
+    public:
+        explicit ProfilePhase(const char* name, std::string pass = "");
+        ~ProfilePhase();
+
+        ProfilePhase(const ProfilePhase&) = delete;
+        ProfilePhase& operator=(const ProfilePhase&) = delete;
+
+    private:
+        bool m_active;
+        PhaseRecord m_record;
+        Profiler::Sample m_begin;
+        ProfilePhase* m_parent;
+    };
+}
@@ -1,8 +1,12 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/regex.hpp>
 
-#include <iostream>
+#include <libxml/parser.h>
+#include <libxml/tree.h>
 
+#include <memory>
+
+#include "Logging.h"
 #include "NotImplementedException.h"
 #include "SchemaParser.h"
 
@@ -10,33 +14,219 @@ namespace tigl {
     namespace xsd {
         namespace {
             const std::string c_simpleContentTypeSuffx = "_SimpleContentType";
+
+            // a node of the schema accessed through TIXI, every query evaluates an xpath
+            class XPathNode {
+            public:
+                XPathNode(const tixihelper::TixiDocument& document, std::string xpath)
+                    : m_document(&document), m_xpath(std::move(xpath)) {}
+
+                auto xpath() const -> const std::string& {
+                    return m_xpath;
+                }
+
+                auto hasAttribute(const std::string& name) const -> bool {
+                    return m_document->checkAttribute(m_xpath, name);
+                }
+
+                auto attribute(const std::string& name) const -> std::string {
+                    return m_document->textAttribute(m_xpath, name);
+                }
+
+                auto hasChild(const std::string& name) const -> bool {
+                    return m_document->checkElement(m_xpath + "/" + name);
+                }
+
+                auto child(const std::string& name) const -> XPathNode {
+                    return XPathNode(*m_document, m_xpath + "/" + name);
+                }
+
+                // calls func(child) for all child elements with the given name
+                template <typename Func>
+                void forEachChild(const std::string& name, Func func) const {
+                    m_document->forEachChild(m_xpath, name, [&](const std::string& xpath) {
+                        func(XPathNode(*m_document, xpath));
+                    });
+                }
+
+                // calls func(child, name) for all child elements
+                template <typename Func>
+                void forEachChild(Func func) const {
+                    m_document->forEachChild(m_xpath, [&](const std::string& xpath, const std::string& name) {
+                        func(XPathNode(*m_document, xpath), name);
+                    });
+                }
+
+                // calls func(child, name) for all child nodes, including text (#text) and CDATA (#cdata-section) nodes
+                template <typename Func>
+                void forEachNode(Func func) const {
+                    int count = 0;
+                    tixiGetNumberOfChilds(m_document->handle(), m_xpath.c_str(), &count);
+
+                    std::unordered_map<std::string, int> childIndex;
+                    for (int i = 1; i <= count; i++) {
+                        char* namePtr = nullptr;
+                        tixiGetChildNodeName(m_document->handle(), m_xpath.c_str(), i, &namePtr);
+
+                        // CDATA sections cannot be selected by xpath, the text of the parent is used instead
+                        const auto name = std::string(namePtr);
+                        if (name == "#cdata-section")
+                            func(*this, name);
+                        else if (name == "#text")
+                            func(XPathNode(*m_document, m_xpath + "/text()[" + std::to_string(++childIndex[name]) + "]"), name);
+                        else
+                            func(XPathNode(*m_document, m_xpath + "/" + name + "[" + std::to_string(++childIndex[name]) + "]"), name);
+                    }
+                }
+
+                auto text() const -> std::string {
+                    return m_document->textElement(m_xpath);
+                }
+
+            private:
+                const tixihelper::TixiDocument* m_document;
+                std::string m_xpath;
+            };
+
+            struct XmlDocDeleter {
+                void operator()(xmlDoc* doc) const {
+                    xmlFreeDoc(doc);
+                }
+            };
+
+            using XmlDocPtr = std::unique_ptr<xmlDoc, XmlDocDeleter>;
+
+            auto qualifiedName(const xmlNode* node) -> std::string {
+                switch (node->type) {
+                    case XML_TEXT_NODE:          return "#text";
+                    case XML_CDATA_SECTION_NODE: return "#cdata-section";
+                    case XML_COMMENT_NODE:       return "#comment";
+                    default: break;
+                }
+                const auto name = std::string(reinterpret_cast<const char*>(node->name));
+                if (node->ns && node->ns->prefix)
+                    return reinterpret_cast<const char*>(node->ns->prefix) + (":" + name);
+                return name;
+            }
+
+            // a node of the schema accessed by walking the libxml2 tree directly.
+            // Produces the same xpaths as XPathNode, but finding children only iterates over the siblings once
+            class TreeNode {
+            public:
+                TreeNode(const xmlNode* node, std::string xpath)
+                    : m_node(node), m_xpath(std::move(xpath)) {}
+
+                auto xpath() const -> const std::string& {
+                    return m_xpath;
+                }
+
+                auto hasAttribute(const std::string& name) const -> bool {
+                    return xmlHasProp(m_node, reinterpret_cast<const xmlChar*>(name.c_str())) != nullptr;
+                }
+
+                auto attribute(const std::string& name) const -> std::string {
+                    const auto value = xmlGetProp(m_node, reinterpret_cast<const xmlChar*>(name.c_str()));
+                    if (!value)
+                        throw std::runtime_error("Attribute " + name + " not found at xpath: " + m_xpath);
+                    const auto result = std::string(reinterpret_cast<const char*>(value));
+                    xmlFree(value);
+                    return result;
+                }
+
+                auto hasChild(const std::string& name) const -> bool {
+                    return findChild(name) != nullptr;
+                }
+
+                auto child(const std::string& name) const -> TreeNode {
+                    const auto node = findChild(name);
+                    if (!node)
+                        throw std::runtime_error("Element " + name + " not found at xpath: " + m_xpath);
+                    return TreeNode(node, m_xpath + "/" + name);
+                }
+
+                template <typename Func>
+                void forEachChild(const std::string& name, Func func) const {
+                    int index = 0;
+                    for (auto node = m_node->children; node; node = node->next)
+                        if (node->type == XML_ELEMENT_NODE && qualifiedName(node) == name)
+                            func(TreeNode(node, m_xpath + "/" + name + "[" + std::to_string(++index) + "]"));
+                }
+
+                template <typename Func>
+                void forEachChild(Func func) const {
+                    std::unordered_map<std::string, int> childIndex;
+                    for (auto node = m_node->children; node; node = node->next) {
+                        if (node->type == XML_ELEMENT_NODE) {
+                            const auto name = qualifiedName(node);
+                            func(TreeNode(node, m_xpath + "/" + name + "[" + std::to_string(++childIndex[name]) + "]"), name);
+                        }
+                    }
+                }
+
+                template <typename Func>
+                void forEachNode(Func func) const {
+                    std::unordered_map<std::string, int> childIndex;
+                    for (auto node = m_node->children; node; node = node->next) {
+                        const auto name = qualifiedName(node);
+                        if (name == "#cdata-section")
+                            func(*this, name);
+                        else if (name == "#text")
+                            func(TreeNode(node, m_xpath + "/text()[" + std::to_string(++childIndex[name]) + "]"), name);
+                        else
+                            func(TreeNode(node, m_xpath + "/" + name + "[" + std::to_string(++childIndex[name]) + "]"), name);
+                    }
+                }
+
+                // same as TIXI: the content of text nodes, the concatenated text and CDATA children of elements
+                auto text() const -> std::string {
+                    if (m_node->type == XML_TEXT_NODE || m_node->type == XML_CDATA_SECTION_NODE)
+                        return m_node->content ? reinterpret_cast<const char*>(m_node->content) : "";
+                    const auto value = xmlNodeListGetString(m_node->doc, m_node->children, 0);
+                    if (!value)
+                        return {};
+                    const auto result = std::string(reinterpret_cast<const char*>(value));
+                    xmlFree(value);
+                    return result;
+                }
+
+            private:
+                auto findChild(const std::string& name) const -> const xmlNode* {
+                    for (auto node = m_node->children; node; node = node->next)
+                        if (node->type == XML_ELEMENT_NODE && qualifiedName(node) == name)
+                            return node;
+                    return nullptr;
+                }
+
+                const xmlNode* m_node;
+                std::string m_xpath;
+            };
         }
 
+        template <typename Node>
         class SchemaParser {
         public:
-            SchemaParser(const std::string& cpacsLocation)
-                : document(tixihelper::TixiDocument::createFromFile(cpacsLocation)) {
-                document.registerNamespaces();
+            SchemaParser(const Node& schema) {
+                m_types.arena = std::make_shared<Arena>();
 
-                document.forEachChild("/xsd:schema", "xsd:simpleType", [&](const std::string& xpath) {
-                    readSimpleType(xpath);
+                schema.forEachChild("xsd:simpleType", [&](const Node& node) {
+                    readSimpleType(node);
                 });
 
-                document.forEachChild("/xsd:schema", "xsd:complexType", [&](const std::string& xpath) {
-                    readComplexType(xpath);
+                schema.forEachChild("xsd:complexType", [&](const Node& node) {
+                    readComplexType(node);
                 });
 
-                document.forEachChild("/xsd:schema", "xsd:element", [&](const std::string& xpath) {
-                    m_types.roots.push_back(readElement(xpath).type);
+                schema.forEachChild("xsd:element", [&](const Node& node) {
+                    m_types.roots.push_back(readElement(node).type);
                 });
             }
 
-            Group readGroup(const std::string& xpath, const std::string& containingTypeName) {
-                throw NotImplementedException("XSD group is not implemented. xpath: " + xpath);
+            Group readGroup(const Node& node, const std::string& containingTypeName) {
+                throw NotImplementedException("XSD group is not implemented. xpath: " + node.xpath());
                 return Group();
             }
 
-            All readAll(const std::string& xpath, const std::string& containingTypeName) {
+            All readAll(const Node& node, const std::string& containingTypeName) {
                 // <all
                 // id = ID
                 // maxOccurs = 1
@@ -46,14 +236,16 @@ namespace tigl {
                 // (annotation? , element*)
                 // </all>
                 All all;
-                all.xpath = xpath;
-                document.forEachChild(xpath, "xsd:element", [&](const std::string& xpath) {
-                    all.elements.push_back(readElement(xpath, containingTypeName));
+                all.xpath = intern(node.xpath());
+                all.elements = collect(m_elementStack, [&] {
+                    node.forEachChild("xsd:element", [&](const Node& node) {
+                        m_elementStack.push_back(readElement(node, containingTypeName));
+                    });
                 });
                 return all;
             }
 
-            Choice readChoice(const std::string& xpath, const std::string& containingTypeName) {
+            Choice readChoice(const Node& node, const std::string& containingTypeName) {
                 // <choice
                 // id=ID
                 // maxOccurs=nonNegativeInteger|unbounded
@@ -63,40 +255,42 @@ namespace tigl {
                 // (annotation?,(element|group|choice|sequence|any)*)
                 // </choice>
                 Choice ch;
-                ch.xpath = xpath;
+                ch.xpath = intern(node.xpath());
 
                 // minOccurs
-                if (!document.checkAttribute(xpath, "minOccurs"))
+                if (!node.hasAttribute("minOccurs"))
                     ch.minOccurs = 1;
                 else {
-                  const auto minOccurs = document.textAttribute(xpath, "minOccurs");
+                  const auto minOccurs = node.attribute("minOccurs");
                   const auto minOccursInt = std::stoi(minOccurs);
                   if (minOccursInt < 0)
-                      throw std::runtime_error("minOccurs is negative: " + xpath);
+                      throw std::runtime_error("minOccurs is negative: " + node.xpath());
                   else if (minOccursInt > 1)
-                      throw std::runtime_error("support for minOccurs>1 not implemented for choices yet: " + xpath);
+                      throw std::runtime_error("support for minOccurs>1 not implemented for choices yet: " + node.xpath());
                   ch.minOccurs = minOccursInt;
                 }
 
-                document.forEachChild(xpath, "xsd:element", [&](const std::string& xpath) {
-                    ch.elements.push_back(readElement(xpath, containingTypeName));
-                });
-                document.forEachChild(xpath, "xsd:group", [&](const std::string& xpath) {
-                    ch.elements.push_back(readGroup(xpath, containingTypeName));
-                });
-                document.forEachChild(xpath, "xsd:choice", [&](const std::string& xpath) {
-                    ch.elements.push_back(readChoice(xpath, containingTypeName));
-                });
-                document.forEachChild(xpath, "xsd:sequence", [&](const std::string& xpath) {
-                    ch.elements.push_back(readSequence(xpath, containingTypeName));
-                });
-                document.forEachChild(xpath, "xsd:any", [&](const std::string& xpath) {
-                    ch.elements.push_back(readAny(xpath, containingTypeName));
+                ch.elements = collect(m_contentStack, [&] {
+                    node.forEachChild("xsd:element", [&](const Node& node) {
+                        m_contentStack.push_back(readElement(node, containingTypeName));
+                    });
+                    node.forEachChild("xsd:group", [&](const Node& node) {
+                        m_contentStack.push_back(readGroup(node, containingTypeName));
+                    });
+                    node.forEachChild("xsd:choice", [&](const Node& node) {
+                        m_contentStack.push_back(readChoice(node, containingTypeName));
+                    });
+                    node.forEachChild("xsd:sequence", [&](const Node& node) {
+                        m_contentStack.push_back(readSequence(node, containingTypeName));
+                    });
+                    node.forEachChild("xsd:any", [&](const Node& node) {
+                        m_contentStack.push_back(readAny(node, containingTypeName));
+                    });
                 });
                 return ch;
             }
 
-            Sequence readSequence(const std::string& xpath, const std::string& containingTypeName) {
+            Sequence readSequence(const Node& node, const std::string& containingTypeName) {
                 // <sequence
                 // id=ID
                 // maxOccurs=nonNegativeInteger|unbounded
@@ -106,28 +300,30 @@ namespace tigl {
                 // (annotation?,(element|group|choice|sequence|any)*)
                 // </sequence>
                 Sequence seq;
-                seq.xpath = xpath;
-                document.forEachChild(xpath, [&](const std::string& xpath, const std::string& element) {
-                    if (element == "xsd:element") {
-                        seq.elements.push_back(readElement(xpath, containingTypeName));
-                    }
-                    else if (element == "xsd:group") {
-                        seq.elements.push_back(readGroup(xpath, containingTypeName));
-                    }
-                    else if (element == "xsd:choice") {
-                        seq.elements.push_back(readChoice(xpath, containingTypeName));
-                    }
-                    else if (element == "xsd:sequence") {
-                        seq.elements.push_back(readSequence(xpath, containingTypeName));
-                    }
-                    else if (element == "xsd:any") {
-                        seq.elements.push_back(readAny(xpath, containingTypeName));
-                    }
+                seq.xpath = intern(node.xpath());
+                seq.elements = collect(m_contentStack, [&] {
+                    node.forEachChild([&](const Node& node, const std::string& element) {
+                        if (element == "xsd:element") {
+                            m_contentStack.push_back(readElement(node, containingTypeName));
+                        }
+                        else if (element == "xsd:group") {
+                            m_contentStack.push_back(readGroup(node, containingTypeName));
+                        }
+                        else if (element == "xsd:choice") {
+                            m_contentStack.push_back(readChoice(node, containingTypeName));
+                        }
+                        else if (element == "xsd:sequence") {
+                            m_contentStack.push_back(readSequence(node, containingTypeName));
+                        }
+                        else if (element == "xsd:any") {
+                            m_contentStack.push_back(readAny(node, containingTypeName));
+                        }
+                    });
                 });
                 return seq;
             }
 
-            Any readAny(const std::string& xpath, const std::string& containingTypeName) {
+            Any readAny(const Node& node, const std::string& containingTypeName) {
                 // <any
                 // id=ID
                 // maxOccurs=nonNegativeInteger|unbounded
@@ -141,12 +337,12 @@ namespace tigl {
                 return Any();
             }
 
-            void readExtension(const std::string& xpath, ComplexType& type) {
-                type.base = document.textAttribute(xpath, "base");
-                readComplexTypeElementConfiguration(xpath, type);
+            void readExtension(const Node& node, ComplexType& type) {
+                type.base = intern(node.attribute("base"));
+                readComplexTypeElementConfiguration(node, type);
             }
 
-            void readSimpleContent(const std::string& xpath, ComplexType& type) {
+            void readSimpleContent(const Node& node, ComplexType& type) {
                 // <simpleContent
                 // id=ID
                 // any attributes
@@ -155,29 +351,30 @@ namespace tigl {
                 // </simpleContent>
 
                 SimpleContent sc;
-                sc.xpath = xpath;
-                if (document.checkElement(xpath + "/xsd:restriction")) {
-                    if (document.checkElement(xpath + "/xsd:restriction/xsd:enumeration")) {
+                sc.xpath = intern(node.xpath());
+                if (node.hasChild("xsd:restriction")) {
+                    const auto restriction = node.child("xsd:restriction");
+                    if (restriction.hasChild("xsd:enumeration")) {
                         // generate an additional type for this enum
                         SimpleType stype;
-                        stype.xpath = xpath;
-                        stype.name = stripTypeSuffix(type.name) + c_simpleContentTypeSuffx;
-                        readRestriction(xpath + "/xsd:restriction", stype);
+                        stype.xpath = intern(node.xpath());
+                        stype.name = intern(stripTypeSuffix(type.name.to_string()) + c_simpleContentTypeSuffx);
+                        readRestriction(restriction, stype);
                         m_types.types[stype.name] = stype;
 
                         sc.type = stype.name;
                     } else {
                         // we simplify this case be creating a field for the value of the simpleContent
-                        sc.type = document.textAttribute(xpath + "/xsd:restriction", "base");
+                        sc.type = intern(restriction.attribute("base"));
                     }
-                } else if (document.checkElement(xpath + "/xsd:extension")) {
+                } else if (node.hasChild("xsd:extension")) {
                     // we simplify this case be creating a field for the value of the simpleContent
-                    sc.type = document.textAttribute(xpath + "/xsd:extension", "base");
+                    sc.type = intern(node.child("xsd:extension").attribute("base"));
                 }
                 type.content = sc;
             }
 
-            void readComplexContent(const std::string& xpath, ComplexType& type) {
+            void readComplexContent(const Node& node, ComplexType& type) {
                 // <complexContent
                 // id=ID
                 // mixed=true|false
@@ -186,110 +383,107 @@ namespace tigl {
                 // (annotation?,(restriction|extension))
                 // </complexContent>
 
-                if (document.checkElement(xpath + "/xsd:restriction"))
-                    throw NotImplementedException("XSD complexType complexContent restriction is not implemented. xpath: " + xpath);
-                else if (document.checkElement(xpath + "/xsd:extension"))
-                    readExtension(xpath + "/xsd:extension", type);
+                if (node.hasChild("xsd:restriction"))
+                    throw NotImplementedException("XSD complexType complexContent restriction is not implemented. xpath: " + node.xpath());
+                else if (node.hasChild("xsd:extension"))
+                    readExtension(node.child("xsd:extension"), type);
             }
 
-            void readComplexTypeElementConfiguration(const std::string& xpath, ComplexType& type) {
-                     if (document.checkElement(xpath + "/xsd:all"))      type.content = readAll(xpath + "/xsd:all", stripTypeSuffix(type.name));
-                else if (document.checkElement(xpath + "/xsd:sequence")) type.content = readSequence(xpath + "/xsd:sequence", stripTypeSuffix(type.name));
-                else if (document.checkElement(xpath + "/xsd:choice"))   type.content = readChoice(xpath + "/xsd:choice", stripTypeSuffix(type.name));
-                else if (document.checkElement(xpath + "/xsd:group"))    type.content = readGroup(xpath + "/xsd:group", stripTypeSuffix(type.name));
-                else if (document.checkElement(xpath + "/xsd:any"))      type.content = readAny(xpath + "/xsd:any", stripTypeSuffix(type.name));
+            void readComplexTypeElementConfiguration(const Node& node, ComplexType& type) {
+                const auto containingTypeName = stripTypeSuffix(type.name.to_string());
+                     if (node.hasChild("xsd:all"))      type.content = readAll(node.child("xsd:all"), containingTypeName);
+                else if (node.hasChild("xsd:sequence")) type.content = readSequence(node.child("xsd:sequence"), containingTypeName);
+                else if (node.hasChild("xsd:choice"))   type.content = readChoice(node.child("xsd:choice"), containingTypeName);
+                else if (node.hasChild("xsd:group"))    type.content = readGroup(node.child("xsd:group"), containingTypeName);
+                else if (node.hasChild("xsd:any"))      type.content = readAny(node.child("xsd:any"), containingTypeName);
 
-                     if (document.checkElement(xpath + "/xsd:complexContent")) readComplexContent(xpath + "/xsd:complexContent", type);
-                else if (document.checkElement(xpath + "/xsd:simpleContent"))  readSimpleContent(xpath + "/xsd:simpleContent", type);
+                     if (node.hasChild("xsd:complexContent")) readComplexContent(node.child("xsd:complexContent"), type);
+                else if (node.hasChild("xsd:simpleContent"))  readSimpleContent(node.child("xsd:simpleContent"), type);
             }
 
-            Attribute readAttribute(const std::string& xpath, const std::string& containingTypeName) {
+            Attribute readAttribute(const Node& node, const std::string& containingTypeName) {
                 Attribute att;
-                att.xpath = xpath;
-                att.name = document.textAttribute(xpath, "name");
+                att.xpath = intern(node.xpath());
+                att.name = intern(node.attribute("name"));
 
-                if (document.checkAttribute(xpath, "type"))
+                if (node.hasAttribute("type"))
                     // referencing other type
-                    att.type = document.textAttribute(xpath, "type");
+                    att.type = intern(node.attribute("type"));
                 else
                     // type defined inline
-                    att.type = readInlineType(xpath, containingTypeName + "_" + att.name);
+                    att.type = intern(readInlineType(node, containingTypeName + "_" + att.name.to_string()));
 
-                if (document.checkAttribute(xpath, "use")) {
-                    const auto use = document.textAttribute(xpath, "use");
+                if (node.hasAttribute("use")) {
+                    const auto use = node.attribute("use");
                     if (use == "optional")
                         att.optional = true;
                     else if (use == "required")
                         att.optional = false;
                     else
-                        throw std::runtime_error("Invalid value for optional attribute at xpath: " + xpath);
+                        throw std::runtime_error("Invalid value for optional attribute at xpath: " + node.xpath());
                 } else {
                     att.optional = true;
                 }
 
-                if (document.checkAttribute(xpath, "default"))
-                    att.defaultValue = document.textAttribute(xpath, "default");
-                if (document.checkAttribute(xpath, "fixed"))
-                    att.fixed = document.textAttribute(xpath, "fixed");
+                if (node.hasAttribute("default"))
+                    att.defaultValue = intern(node.attribute("default"));
+                if (node.hasAttribute("fixed"))
+                    att.fixed = intern(node.attribute("fixed"));
 
                 // documentation
-                auto docXPath = xpath;
-                if (document.checkElement(docXPath += "/xsd:annotation"))
-                    if (document.checkElement(docXPath += "/xsd:documentation"))
-                        readSchemaDoc(document, att.documentation, docXPath);
+                if (node.hasChild("xsd:annotation")) {
+                    const auto annotation = node.child("xsd:annotation");
+                    if (annotation.hasChild("xsd:documentation"))
+                        att.documentation = readDocumentation(annotation.child("xsd:documentation"));
+                }
 
                 return att;
             }
 
-            void readSchemaDoc(tixihelper::TixiDocument& document, std::string& result, const std::string& xpath) {
-                int count = 0;
-                tixiGetNumberOfChilds(document.handle(), xpath.c_str(), &count);
-
-                std::unordered_map<std::string, int> childIndex;
-
-                for (int i = 1; i <= count; i++) {
-                    char* namePtr = nullptr;
-                    tixiGetChildNodeName(document.handle(), xpath.c_str(), i, &namePtr);
+            auto readDocumentation(const Node& node) -> String {
+                std::string result;
+                readSchemaDoc(node, result);
+                return intern(result);
+            }
 
-                    const auto name = std::string(namePtr);
+            void readSchemaDoc(const Node& node, std::string& result) {
+                node.forEachNode([&](const Node& child, const std::string& name) {
                     if (name == "#text" || name == "#cdata-section") {
-                        const auto childXPath = (name == "#text") ? xpath + "/text()[" + std::to_string(++childIndex[name]) + "]"
-                                                                  : xpath;
-                        auto text = document.textElement(childXPath);
+                        auto text = child.text();
                         static boost::regex r("^\\s*");
                         text = boost::regex_replace(text, r, ""); // clear leading whitespace on each line
                         boost::trim_right(text); // clear trailing whitespace after last line
                         if (!result.empty() && result.back() != '\n')
                             result += ' ';
                         result += text;
-                        continue;
+                        return;
                     }
 
-                    const auto childXPath = xpath + "/" + name + "[" + std::to_string(++childIndex[name]) + "]";
-
                     if (name == "ddue:summary") {
                         result += "@brief";
-                        readSchemaDoc(document, result, childXPath);
+                        readSchemaDoc(child, result);
                         result += '\n';
                     } else if (name == "ddue:para" || name == "ddue:title") {
-                        readSchemaDoc(document, result, childXPath);
+                        readSchemaDoc(child, result);
                         result += "\n";
                     } else if (name == "ddue:code") {
                         result += "\n";
-                        readSchemaDoc(document, result, childXPath);
+                        readSchemaDoc(child, result);
                         result += "\n";
                     } else if (name == "ddue:mediaLink") {
-                        const auto imageXPath = childXPath + "/ddue:image";
-                        if (document.checkElement(imageXPath) && document.checkAttribute(imageXPath, "href")) {
-                            const auto href = document.textAttribute(imageXPath, "href");
-                            result += "@see " + href + '\n';
+                        if (child.hasChild("ddue:image")) {
+                            const auto image = child.child("ddue:image");
+                            if (image.hasAttribute("href")) {
+                                const auto href = image.attribute("href");
+                                result += "@see " + href + '\n';
+                            }
                         }
                     } else
-                        readSchemaDoc(document, result, childXPath);
-                }
+                        readSchemaDoc(child, result);
+                });
             }
 
-            std::string readComplexType(const std::string& xpath, const std::string& nameHint = "") {
+            std::string readComplexType(const Node& node, const std::string& nameHint = "") {
                 // <complexType
                 // id=ID
                 // name=NCName
@@ -304,8 +498,8 @@ namespace tigl {
 
                     // read or generate type name
                 const std::string name = [&] {
-                    if (document.checkAttribute(xpath, "name"))
-                        return document.textAttribute(xpath, "name");
+                    if (node.hasAttribute("name"))
+                        return node.attribute("name");
                     else
                         return generateUniqueTypeName(nameHint);
                 }();
@@ -314,61 +508,67 @@ namespace tigl {
                     throw std::runtime_error("Type with name " + name + " already exists");
 
                 ComplexType type;
-                type.xpath = xpath;
-                type.name = name;
-
-                if (document.checkAttribute(xpath, "id"))
-                    throw NotImplementedException("XSD complextype id is not implemented. xpath: " + xpath);
-                if (document.checkAttribute(xpath, "abstract"))
-                    throw NotImplementedException("XSD complextype abstract is not implemented. xpath: " + xpath);
-                if (document.checkAttribute(xpath, "mixed"))
-                    throw NotImplementedException("XSD complextype mixed is not implemented. xpath: " + xpath);
-                if (document.checkAttribute(xpath, "block"))
-                    throw NotImplementedException("XSD complextype block is not implemented. xpath: " + xpath);
-                if (document.checkAttribute(xpath, "final"))
-                    throw NotImplementedException("XSD complextype final is not implemented. xpath: " + xpath);
+                type.xpath = intern(node.xpath());
+                type.name = intern(name);
+
+                if (node.hasAttribute("id"))
+                    throw NotImplementedException("XSD complextype id is not implemented. xpath: " + node.xpath());
+                if (node.hasAttribute("abstract"))
+                    throw NotImplementedException("XSD complextype abstract is not implemented. xpath: " + node.xpath());
+                if (node.hasAttribute("mixed"))
+                    throw NotImplementedException("XSD complextype mixed is not implemented. xpath: " + node.xpath());
+                if (node.hasAttribute("block"))
+                    throw NotImplementedException("XSD complextype block is not implemented. xpath: " + node.xpath());
+                if (node.hasAttribute("final"))
+                    throw NotImplementedException("XSD complextype final is not implemented. xpath: " + node.xpath());
 
                 // read element configuration
-                readComplexTypeElementConfiguration(xpath, type);
+                readComplexTypeElementConfiguration(node, type);
 
                 // read attributes
-                for (const auto& path : {
-                    xpath,
-                    xpath + "/xsd:complexContent/xsd:restriction",
-                    xpath + "/xsd:complexContent/xsd:extension",
-                    xpath + "/xsd:simpleContent/xsd:restriction",
-                    xpath + "/xsd:simpleContent/xsd:extension",
-                }) {
-                    if (document.checkElement(path)) {
-                        document.forEachChild(path, "xsd:attribute", [&](const std::string& xpath) {
-                            type.attributes.push_back(readAttribute(xpath, name));
-                        });
-                        if (document.checkElement(xpath + "/xsd:attributeGroup")) {
-                            throw NotImplementedException("XSD complexType attributeGroup is not implemented. xpath: " + xpath);
-                        }
+                const auto attributesBegin = m_attributeStack.size();
+                auto readAttributes = [&](const Node& attributesNode) {
+                    attributesNode.forEachChild("xsd:attribute", [&](const Node& node) {
+                        m_attributeStack.push_back(readAttribute(node, name));
+                    });
+                    if (node.hasChild("xsd:attributeGroup")) {
+                        throw NotImplementedException("XSD complexType attributeGroup is not implemented. xpath: " + node.xpath());
+                    }
+                };
+                readAttributes(node);
+                for (const auto& content : { "xsd:complexContent", "xsd:simpleContent" }) {
+                    if (node.hasChild(content)) {
+                        const auto contentNode = node.child(content);
+                        for (const auto& derivation : { "xsd:restriction", "xsd:extension" })
+                            if (contentNode.hasChild(derivation))
+                                readAttributes(contentNode.child(derivation));
                     }
                 }
+                type.attributes = moveToArena(m_attributeStack, attributesBegin);
 
                 // read documentation
-                auto docXPath = xpath;
-                if (document.checkElement(docXPath += "/xsd:annotation"))
-                    if (document.checkElement(docXPath += "/xsd:appinfo"))
-                        if (document.checkElement(docXPath += "/sd:schemaDoc"))
-                            readSchemaDoc(document, type.documentation, docXPath);
+                if (node.hasChild("xsd:annotation")) {
+                    const auto annotation = node.child("xsd:annotation");
+                    if (annotation.hasChild("xsd:appinfo")) {
+                        const auto appinfo = annotation.child("xsd:appinfo");
+                        if (appinfo.hasChild("sd:schemaDoc"))
+                            type.documentation = readDocumentation(appinfo.child("sd:schemaDoc"));
+                    }
+                }
 
                 // try to inline simple contents
-                if (type.attributes.empty() && type.base.empty() && type.content.is<SimpleContent>()) {
+                if (type.attributes.empty() && type.base.empty() && type.content.template is<SimpleContent>()) {
                     // this is just an empty type with a simple content, just use the type generated for the simple content
-                    const auto& sc = type.content.as<SimpleContent>();
-                    auto simpleContentTypeName = sc.type;
+                    const auto& sc = type.content.template as<SimpleContent>();
+                    auto simpleContentTypeName = sc.type.to_string();
 
                     // if the inner typ is an enum, replace outer type, otherwise we assume it is a primitive type
-                    auto& resolvedType = m_types.types[simpleContentTypeName];
-                    if ((resolvedType.is<SimpleType>() && !resolvedType.as<SimpleType>().restrictionValues.empty())) {
+                    auto& resolvedType = m_types.types[sc.type];
+                    if ((resolvedType.template is<SimpleType>() && !resolvedType.template as<SimpleType>().restrictionValues.empty())) {
 
                         // move simple content type out of type map
                         auto v = std::move(resolvedType);
-                        m_types.types.erase(simpleContentTypeName);
+                        m_types.types.erase(sc.type);
 
                         // strip simple content suffix, if exists
                         const auto it = simpleContentTypeName.rfind(c_simpleContentTypeSuffx);
@@ -378,31 +578,32 @@ namespace tigl {
                         simpleContentTypeName += "Type"; // readd Type suffix
 
                         // rename simple content type to outer type
-                        assert(v.is<SimpleType>());
-                        v.as<SimpleType>().name = simpleContentTypeName;
+                        assert(v.template is<SimpleType>());
+                        auto& renamed = v.template as<SimpleType>();
+                        renamed.name = intern(simpleContentTypeName);
 
                         // readd it
-                        m_types.types[simpleContentTypeName] = v;
+                        m_types.types[renamed.name] = v;
                     }
-                    else if (resolvedType.is<ComplexType>())
+                    else if (resolvedType.template is<ComplexType>())
                     {
                         // in case of a restriction of a complexType directly use the referenced complex type
-                        type = resolvedType.as<ComplexType>();
-                        type.name = name;
+                        type = resolvedType.template as<ComplexType>();
+                        type.name = intern(name);
 
                         // add new type
-                        m_types.types[name] = type;
+                        m_types.types[type.name] = type;
                     }
                     return simpleContentTypeName;
                 }
 
                 // add
-                m_types.types[name] = type;
+                m_types.types[type.name] = type;
 
                 return name;
             }
 
-            void readRestriction(const std::string& xpath, SimpleType& type) {
+            void readRestriction(const Node& node, SimpleType& type) {
                 // <restriction
                 // id = ID
                 // base = QName
@@ -416,32 +617,33 @@ namespace tigl {
                 // (annotation?, (group | all | choice | sequence)?, ((attribute | attributeGroup)*, anyAttribute?))
                 // </restriction>
 
-                type.base = document.textAttribute(xpath, "base");
+                type.base = intern(node.attribute("base"));
 
-                document.forEachChild(xpath, "xsd:enumeration", [&](const std::string& expath) {
-                    const auto enumValue = document.textAttribute(expath, "value");
-                    type.restrictionValues.push_back(enumValue);
+                type.restrictionValues = collect(m_valueStack, [&] {
+                    node.forEachChild("xsd:enumeration", [&](const Node& enode) {
+                        m_valueStack.push_back(intern(enode.attribute("value")));
+                    });
                 });
 
                 auto writeError = [&](const char* element) {
-                    std::cerr << "XSD restriction " << element << " is not implemented. No restrictions will be checked by generated code" << std::endl;
+                    log(LogLevel::Warning) << "XSD restriction " << element << " is not implemented. No restrictions will be checked by generated code";
                 };
 
-                if (document.checkElement(xpath + "/xsd:simpleType"    )) throw NotImplementedException("XSD restriction simpleType is not implemented. xpath: " + xpath);
-                if (document.checkElement(xpath + "/xsd:minExclusive"  )) writeError("minExclusive"  );
-                if (document.checkElement(xpath + "/xsd:minInclusive"  )) writeError("minInclusive"  );
-                if (document.checkElement(xpath + "/xsd:maxExclusive"  )) writeError("maxExclusive"  );
-                if (document.checkElement(xpath + "/xsd:maxInclusive"  )) writeError("maxInclusive"  );
-                if (document.checkElement(xpath + "/xsd:totalDigits"   )) writeError("totalDigits"   );
-                if (document.checkElement(xpath + "/xsd:fractionDigits")) writeError("fractionDigits");
-                if (document.checkElement(xpath + "/xsd:length"        )) writeError("length"        );
-                if (document.checkElement(xpath + "/xsd:minLength"     )) writeError("minLength"     );
-                if (document.checkElement(xpath + "/xsd:maxLength"     )) writeError("maxLength"     );
-                if (document.checkElement(xpath + "/xsd:whiteSpace"    )) writeError("whiteSpace"    );
-                if (document.checkElement(xpath + "/xsd:pattern"       )) writeError("pattern"       );
+                if (node.hasChild("xsd:simpleType"    )) throw NotImplementedException("XSD restriction simpleType is not implemented. xpath: " + node.xpath());
+                if (node.hasChild("xsd:minExclusive"  )) writeError("minExclusive"  );
+                if (node.hasChild("xsd:minInclusive"  )) writeError("minInclusive"  );
+                if (node.hasChild("xsd:maxExclusive"  )) writeError("maxExclusive"  );
+                if (node.hasChild("xsd:maxInclusive"  )) writeError("maxInclusive"  );
+                if (node.hasChild("xsd:totalDigits"   )) writeError("totalDigits"   );
+                if (node.hasChild("xsd:fractionDigits")) writeError("fractionDigits");
+                if (node.hasChild("xsd:length"        )) writeError("length"        );
+                if (node.hasChild("xsd:minLength"     )) writeError("minLength"     );
+                if (node.hasChild("xsd:maxLength"     )) writeError("maxLength"     );
+                if (node.hasChild("xsd:whiteSpace"    )) writeError("whiteSpace"    );
+                if (node.hasChild("xsd:pattern"       )) writeError("pattern"       );
             }
 
-            std::string readSimpleType(const std::string& xpath, const std::string& nameHint = "") {
+            std::string readSimpleType(const Node& node, const std::string& nameHint = "") {
                 // <simpleType
                 // id=ID
                 // name=NCName
@@ -452,8 +654,8 @@ namespace tigl {
 
                 // read or generate type name
                 const std::string name = [&] {
-                    if (document.checkAttribute(xpath, "name"))
-                        return document.textAttribute(xpath, "name");
+                    if (node.hasAttribute("name"))
+                        return node.attribute("name");
                     else {
                         return generateUniqueTypeName(nameHint);
                     }
@@ -463,79 +665,82 @@ namespace tigl {
                     throw std::runtime_error("Type with name " + name + " already exists");
 
                 SimpleType type;
-                type.xpath = xpath;
-                type.name = name;
+                type.xpath = intern(node.xpath());
+                type.name = intern(name);
 
-                if (document.checkAttribute(xpath, "id"))
-                    throw NotImplementedException("XSD complextype id is not implemented. xpath: " + xpath);
+                if (node.hasAttribute("id"))
+                    throw NotImplementedException("XSD complextype id is not implemented. xpath: " + node.xpath());
 
-                     if (document.checkElement(xpath + "/xsd:restriction")) readRestriction(xpath + "/xsd:restriction", type);
-                else if (document.checkElement(xpath + "/xsd:list"       )) throw NotImplementedException("XSD simpleType list is not implemented. xpath: " + xpath);
-                else if (document.checkElement(xpath + "/xsd:union"      )) throw NotImplementedException("XSD simpleType union is not implemented. xpath: " + xpath);
+                     if (node.hasChild("xsd:restriction")) readRestriction(node.child("xsd:restriction"), type);
+                else if (node.hasChild("xsd:list"       )) throw NotImplementedException("XSD simpleType list is not implemented. xpath: " + node.xpath());
+                else if (node.hasChild("xsd:union"      )) throw NotImplementedException("XSD simpleType union is not implemented. xpath: " + node.xpath());
 
                 // add only simple types with restrictions (will become enums), otherwise just return underlying type
                 if (!type.restrictionValues.empty()) {
-                    m_types.types[name] = type;
+                    m_types.types[type.name] = type;
                     return name;
                 } else
-                    return type.base;
+                    return type.base.to_string();
             }
 
-            std::string readInlineType(const std::string& xpath, const std::string& nameHint) {
-                     if (document.checkElement(xpath + "/xsd:complexType")) return readComplexType(xpath + "/xsd:complexType", nameHint);
-                else if (document.checkElement(xpath + "/xsd:simpleType" )) return readSimpleType (xpath + "/xsd:simpleType",  nameHint);
-                else throw std::runtime_error("Unexpected type or no type at xpath: " + xpath);
+            std::string readInlineType(const Node& node, const std::string& nameHint) {
+                     if (node.hasChild("xsd:complexType")) return readComplexType(node.child("xsd:complexType"), nameHint);
+                else if (node.hasChild("xsd:simpleType" )) return readSimpleType (node.child("xsd:simpleType"),  nameHint);
+                else throw std::runtime_error("Unexpected type or no type at xpath: " + node.xpath());
             }
 
-            Element readElement(const std::string& xpath, const std::string& containingTypeName = "") {
+            Element readElement(const Node& node, const std::string& containingTypeName = "") {
                 Element element;
-                element.xpath = xpath;
-                element.name = document.textAttribute(xpath, "name");
+                element.xpath = intern(node.xpath());
+                element.name = intern(node.attribute("name"));
 
                 // minOccurs
-                if (!document.checkAttribute(xpath, "minOccurs"))
+                if (!node.hasAttribute("minOccurs"))
                     element.minOccurs = 1;
                 else {
-                    const auto minOccurs = document.textAttribute(xpath, "minOccurs");
+                    const auto minOccurs = node.attribute("minOccurs");
                     const auto minOccursInt = std::stoi(minOccurs);
                     if (minOccursInt < 0)
-                        throw std::runtime_error("minOccurs is negative: " + xpath);
+                        throw std::runtime_error("minOccurs is negative: " + node.xpath());
                     element.minOccurs = minOccursInt;
                 }
 
                 // maxOccurs
-                if (!document.checkAttribute(xpath, "maxOccurs"))
+                if (!node.hasAttribute("maxOccurs"))
                     element.maxOccurs = 1;
                 else {
-                    const auto maxOccurs = document.textAttribute(xpath, "maxOccurs");
+                    const auto maxOccurs = node.attribute("maxOccurs");
                     if (maxOccurs == "unbounded")
                         element.maxOccurs = unbounded;
                     else {
                         const auto maxOccursInt = std::stoi(maxOccurs);
                         if (maxOccursInt < 0)
-                            throw std::runtime_error("maxOccurs is negative: " + xpath);
+                            throw std::runtime_error("maxOccurs is negative: " + node.xpath());
                         element.maxOccurs = maxOccursInt;
                     }
                 }
 
                 // type
-                if (document.checkAttribute(xpath, "type"))
+                if (node.hasAttribute("type"))
                     // referencing other type
-                    element.type = document.textAttribute(xpath, "type");
-                else
-                    element.type = readInlineType(xpath, containingTypeName.empty() ? element.name : containingTypeName + "_" + element.name);
+                    element.type = intern(node.attribute("type"));
+                else {
+                    const auto name = element.name.to_string();
+                    element.type = intern(readInlineType(node, containingTypeName.empty() ? name : containingTypeName + "_" + name));
+                }
 
                 assert(!element.type.empty());
 
                 // default
-                if (document.checkAttribute(xpath, "default"))
-                    element.defaultValue = document.textAttribute(xpath, "default");
+                if (node.hasAttribute("default"))
+                    element.defaultValue = intern(node.attribute("default"));
 
                 // documentation
-                auto docXPath = xpath;
-                if (document.checkElement(docXPath += "/xsd:annotation"))
-                    if (document.checkElement(docXPath += "/xsd:documentation"))
-                        readSchemaDoc(document, element.documentation, docXPath);
+                if (node.hasChild("xsd:annotation")) {
+                    const auto annotation = node.child("xsd:annotation");
+                    if (annotation.hasChild("xsd:documentation"))
+                        element.documentation = readDocumentation(annotation.child("xsd:documentation"));
+                }
 
                 return element;
             }
@@ -555,8 +760,34 @@ namespace tigl {
                 return n;
             }
 
-            tixihelper::TixiDocument document;
+            auto intern(const std::string& str) -> String {
+                return m_types.arena->intern(str);
+            }
+
+            // moves the values on top of the stack, starting at begin, into the arena
+            template <typename T>
+            auto moveToArena(std::vector<T>& stack, std::size_t begin) -> Span<const T> {
+                const auto result = m_types.arena->store(std::begin(stack) + begin, std::end(stack));
+                stack.erase(std::begin(stack) + begin, std::end(stack));
+                return result;
+            }
+
+            // readChildren pushes the children of a node onto stack and returns them as contiguous array in the arena.
+            // Nested nodes complete before their parent, so their children are already removed from the stack again
+            template <typename T, typename Func>
+            auto collect(std::vector<T>& stack, Func readChildren) -> Span<const T> {
+                const auto begin = stack.size();
+                readChildren();
+                return moveToArena(stack, begin);
+            }
+
             SchemaTypes m_types;
+
+            // children of the nodes currently being read, reused for all nodes
+            std::vector<Variant<Element, Group, Choice, Sequence, Any>> m_contentStack;
+            std::vector<Element> m_elementStack;
+            std::vector<Attribute> m_attributeStack;
+            std::vector<String> m_valueStack;
         };
 
         namespace {
@@ -568,9 +799,32 @@ namespace tigl {
             }
         }
 
-        auto parseSchema(const std::string & cpacsLocation) -> SchemaTypes {
-            SchemaParser schema(cpacsLocation);
-            return std::move(schema.m_types);
+        auto parseSchema(const std::string & cpacsLocation, ParserBackend backend) -> SchemaTypes {
+            switch (backend) {
+                case ParserBackend::Tixi: {
+                    auto document = tixihelper::TixiDocument::createFromFile(cpacsLocation);
+                    document.registerNamespaces();
+                    SchemaParser<XPathNode> schema(XPathNode(document, "/xsd:schema"));
+                    return std::move(schema.m_types);
+                }
+                case ParserBackend::LibXml2: {
+                    // libxml2 must be initialized once before documents may be parsed concurrently
+                    static const auto initialized = (xmlInitParser(), true);
+                    (void)initialized;
+
+                    // blanks are dropped like TIXI does, so documentation text is read identically
+                    const XmlDocPtr document(xmlReadFile(cpacsLocation.c_str(), nullptr, XML_PARSE_NOBLANKS));
+                    if (!document)
+                        throw std::runtime_error("Failed to open schema file " + cpacsLocation);
+                    const auto root = xmlDocGetRootElement(document.get());
+                    if (!root)
+                        throw std::runtime_error("Schema file " + cpacsLocation + " has no root element");
+                    SchemaParser<TreeNode> schema(TreeNode(root, "/" + qualifiedName(root)));
+                    return std::move(schema.m_types);
+                }
+                default:
+                    throw std::logic_error("Unknown parser backend");
+            }
         }
 
         auto stripTypeSuffix(const std::string& name) -> std::string {
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <boost/functional/hash.hpp>
+#include <boost/utility/string_view.hpp>
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <limits>
 #include <unordered_map>
 
+#include "Arena.h"
+#include "Span.h"
 #include "TixiDocument.h"
 #include "Variant.hpp"
 
@@ -13,26 +18,30 @@ namespace tigl {
     namespace xsd {
         constexpr int unbounded = std::numeric_limits<unsigned int>::max();
 
+        // the nodes of the schema and their strings live in the Arena of the SchemaTypes they were parsed into.
+        // Strings view into its interned buffer, children are contiguous arrays inside it
+        using String = boost::string_view;
+
         struct XSDElement {
-            std::string xpath;
+            String xpath;
         };
 
         struct Attribute : XSDElement {
-            std::string name;
-            std::string type;
-            std::string defaultValue;
-            std::string fixed;
+            String name;
+            String type;
+            String defaultValue;
+            String fixed;
             bool optional;
-            std::string documentation;
+            String documentation;
         };
 
         struct Element : XSDElement {
-            std::string name;
-            std::string type;
+            String name;
+            String type;
             unsigned int minOccurs;
             unsigned int maxOccurs;
-            std::string defaultValue;
-            std::string documentation;
+            String defaultValue;
+            String documentation;
         };
 
         struct Any : XSDElement {
@@ -44,44 +53,53 @@ namespace tigl {
         };
 
         struct All : XSDElement {
-            std::vector<Element> elements;
+            Span<const Element> elements;
         };
 
         struct Choice;
         struct Sequence : XSDElement {
-            std::vector<Variant<Element, Group, Choice, Sequence, Any>> elements;
+            Span<const Variant<Element, Group, Choice, Sequence, Any>> elements;
         };
 
         struct Choice : XSDElement {
-            std::vector<Variant<Element, Group, Choice, Sequence, Any>> elements;
+            Span<const Variant<Element, Group, Choice, Sequence, Any>> elements;
             unsigned int minOccurs;
         };
 
         struct SimpleContent : XSDElement {
-            std::string type;
+            String type;
         };
 
         struct Type : XSDElement {
-            std::string name;
-            std::string base;
+            String name;
+            String base;
         };
 
         struct ComplexType : Type {
             Variant<Group, All, Choice, Sequence, SimpleContent, Any> content;
-            std::vector<Attribute> attributes;
-            std::string documentation;
+            Span<const Attribute> attributes;
+            String documentation;
         };
 
         struct SimpleType : Type {
-            std::vector<std::string> restrictionValues;
+            Span<const String> restrictionValues;
         };
 
+        // copies share the arena
         struct SchemaTypes {
-            std::vector<std::string> roots;
-            std::unordered_map<std::string, Variant<ComplexType, SimpleType>> types;
+            std::shared_ptr<Arena> arena;
+            std::vector<String> roots;
+            std::unordered_map<String, Variant<ComplexType, SimpleType>, boost::hash<String>> types;
+        };
+
+        // Tixi evaluates an xpath for every query, LibXml2 walks the tree of libxml2 (which TIXI is based on) directly.
+        // Both produce the same SchemaTypes, LibXml2 is considerably faster on large schemas
+        enum class ParserBackend {
+            Tixi,
+            LibXml2
         };
 
-        auto parseSchema(const std::string& cpacsLocation) -> SchemaTypes;
+        auto parseSchema(const std::string& cpacsLocation, ParserBackend backend = ParserBackend::LibXml2) -> SchemaTypes;
 
         auto stripTypeSuffix(const std::string& name) -> std::string;
         auto stripSimpleContentSuffix(const std::string& name) -> std::string;
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+
+namespace tigl {
+    // non owning
+    // view of a contiguous range of elements
+    template <typename T>
+    class Span {
+    public:
+        using iterator = T*;
+        using const_iterator = T*;
+
+        Span() = default;
+        Span(T* begin, T* end)
+            : m_begin(begin), m_end(end) {}
+
+        auto begin() const -> T* { return m_begin; }
+        auto end() const -> T* { return m_end; }
+        auto size() const -> std::size_t { return static_cast<std::size_t>(m_end - m_begin); }
+        auto empty() const -> bool { return m_begin == m_end; }
+        auto operator[](std::size_t i) const -> T& { return m_begin[i]; }
+
+    private:
+        T* m_begin = nullptr;
+        T* m_end = nullptr;
+    };
+}
@@ -1,8 +1,8 @@
 #include <fstream>
 #include <sstream>
-#include <iostream>
 
 #include "Tables.h"
+#include "Logging.h"
 
 namespace tigl {
     Table::Table(std::unordered_set<std::string> data)
@@ -15,11 +15,11 @@ namespace tigl {
     void Table::read(const std::string& filename) {
         std::ifstream f(filename);
         if (!f) {
-            std::cerr << "Warning: Failed to open file " << filename << " for reading. No table data loaded" << std::endl;
+            log(LogLevel::Warning) << "Failed to open file " << filename << " for reading. No table data loaded";
             return;
         }
 
-        std::cout << "Reading table " << filename << std::endl;
+        log(LogLevel::Info) << "Reading table " << filename;
 
         std::string line;
         while (std::getline(f, line)) {
@@ -32,7 +32,7 @@ namespace tigl {
             std::string name;
             ss >> name;
 
-            std::cout << "\t" << name << std::endl;
+            log(LogLevel::Debug) << "\t" << name;
             m_set.insert(name);
         }
     }
@@ -51,11 +51,11 @@ namespace tigl {
     void MappingTable::read(const std::string& filename) {
         std::ifstream f(filename);
         if (!f) {
-            std::cerr << "Warning: Failed to open file " << filename << " for reading. No table data loaded" << std::endl;
+            log(LogLevel::Warning) << "Failed to open file " << filename << " for reading. No table data loaded";
             return;
         }
 
-        std::cout << "Reading mapping table " << filename << std::endl;
+        log(LogLevel::Info) << "Reading mapping table " << filename;
 
         std::string line;
         while (std::getline(f, line)) {
@@ -69,7 +69,7 @@ namespace tigl {
             std::string second;
             ss >> first >> second;
 
-            std::cout << "\t" << first << " -> " << second << std::endl;
+            log(LogLevel::Debug) << "\t" << first << " -> " << second;
             m_map.insert(std::make_pair(first, second));
         }
     }
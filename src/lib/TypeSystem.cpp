@@ -3,11 +3,17 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/range/adaptors.hpp>
 
-#include <iostream>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <numeric>
 #include <cctype>
 #include <fstream>
 
+#include "Hash.h"
+#include "Logging.h"
 #include "NotImplementedException.h"
+#include "Profiler.h"
 #include "Tables.h"
 
 namespace tigl {
@@ -27,13 +33,142 @@ namespace tigl {
             return name;
         }
 
-        auto resolveType(const xsd::SchemaTypes& types, const std::string& name, const Tables& tables) -> std::string {
+        // for every class, determines whether a class satisfying pred is reachable from it, including itself, along the given relations.
+        // Strongly connected components (Tarjan) share their result, so cycles are handled and every class and edge is visited only once
+        template <typename Pred>
+        auto reachesAny(const std::vector<Class>& classes, std::initializer_list<const Adjacency<Class>*> relations, Pred pred) -> std::vector<bool> {
+            struct Frame {
+                std::size_t node;
+                std::size_t relation;
+                std::size_t next;
+                bool reaches;
+            };
+
+            const auto unvisited = std::numeric_limits<std::size_t>::max();
+            std::vector<std::size_t> index(classes.size(), unvisited);
+            std::vector<std::size_t> lowlink(classes.size());
+            std::vector<bool> onStack(classes.size(), false);
+            std::vector<bool> result(classes.size(), false);
+            std::vector<std::size_t> stack;
+            std::vector<Frame> frames;
+            std::size_t counter = 0;
+
+            const auto visit = [&](std::size_t n) {
+                index[n] = lowlink[n] = counter++;
+                stack.push_back(n);
+                onStack[n] = true;
+                frames.push_back(Frame{ n, 0, 0, pred(classes[n]) });
+            };
+
+            for (std::size_t root = 0; root < classes.size(); root++) {
+                if (index[root] != unvisited)
+                    continue;
+                visit(root);
+                while (!frames.empty()) {
+                    auto& f = frames.back();
+                    if (f.relation < relations.size()) {
+                        const auto row = relations.begin()[f.relation]->row(f.node);
+                        if (f.next == row.size()) {
+                            f.relation++;
+                            f.next = 0;
+                            continue;
+                        }
+                        const auto s = static_cast<std::size_t>(row[f.next++] - classes.data());
+                        if (index[s] == unvisited)
+                            visit(s);
+                        else if (onStack[s])
+                            // same component, its result is collected by the component's root
+                            lowlink[f.node] = std::min(lowlink[f.node], index[s]);
+                        else
+                            f.reaches = f.reaches || result[s];
+                        continue;
+                    }
+
+                    const auto n = f.node;
+                    const auto reaches = f.reaches;
+                    frames.pop_back();
+
+                    if (lowlink[n] == index[n]) {
+                        // n is the root of a component, all members are above it on the stack
+                        std::size_t m;
+                        do {
+                            m = stack.back();
+                            stack.pop_back();
+                            onStack[m] = false;
+                            result[m] = reaches;
+                        } while (m != n);
+                    }
+
+                    if (!frames.empty()) {
+                        auto& parent = frames.back();
+                        lowlink[parent.node] = std::min(lowlink[parent.node], lowlink[n]);
+                        parent.reaches = parent.reaches || reaches;
+                    }
+                }
+            }
+            return result;
+        }
+
+        // sorts and deduplicates the edges (source index, target) and stores them in compressed sparse row layout.
+        // Targets are ordered by address, which is their order in the TypeSystem and thus by name
+        template <typename T>
+        void buildAdjacency(Adjacency<T>& adjacency, std::size_t nodeCount, std::vector<std::pair<std::size_t, T*>> edges) {
+            std::sort(std::begin(edges), std::end(edges), [](const std::pair<std::size_t, T*>& a, const std::pair<std::size_t, T*>& b) {
+                return a.first != b.first ? a.first < b.first : std::less<T*>()(a.second, b.second);
+            });
+            edges.erase(std::unique(std::begin(edges), std::end(edges)), std::end(edges));
+
+            adjacency.offsets.assign(nodeCount + 1, 0);
+            adjacency.targets.clear();
+            adjacency.targets.reserve(edges.size());
+            for (const auto& e : edges) {
+                adjacency.offsets[e.first + 1]++;
+                adjacency.targets.push_back(e.second);
+            }
+            std::partial_sum(std::begin(adjacency.offsets), std::end(adjacency.offsets), std::begin(adjacency.offsets));
+        }
+
+        // strips the decorations of generated inline enum names, enums with equal values and equal stripped names are collapsed
+        auto stripNumber(std::string name) -> std::string {
+            // handle inline enum types
+            // generated names are of the form: <containing type name>_<element name>[_SimpleContent][_<counter>]
+
+            // remove optional digits and underscore at the end
+            while (!name.empty() && std::isdigit(name.back()))
+                name.pop_back();
+            if (name.back() == '_')
+                name.erase(name.length() - 1);
+
+            // remove _SimpleContent
+            name = xsd::stripSimpleContentSuffix(name);
+
+            // if type contains an underscore, remove preceding part
+            const auto& pos = name.find_last_of('_');
+            if (pos != std::string::npos)
+                name.erase(0, pos + 1);
+
+            // capitalize first letter
+            name[0] = std::toupper(name[0]);
+
+            // strip Type suffix if exists
+            name = xsd::stripTypeSuffix(name);
+
+            // prefix CPACS if not exists
+            if (name.compare(0, 5, "CPACS") != 0)
+                name = "CPACS" + name;
+
+            return name;
+        }
+
+        auto resolveType(const xsd::SchemaTypes& types, xsd::String type, const Tables& tables) -> std::string {
+            const auto name = type.to_string();
+
             // apply type substitution
             if (const auto p = tables.m_typeSubstitutions.find(name))
                 return *p;
 
             // search simple and complex types
-            const auto cit = types.types.find(name);
+            const auto cit = types.types.find(type);
             if (cit != std::end(types.types))
                 return makeClassName(name);
 
@@ -44,13 +179,13 @@ namespace tigl {
             throw std::runtime_error("Unknown type: " + name);
         }
 
-        auto resolveComplexType(const xsd::SchemaTypes& types, const std::string& name, const Tables& tables) -> const xsd::ComplexType& {
+        auto resolveComplexType(const xsd::SchemaTypes& types, xsd::String name, const Tables& tables) -> const xsd::ComplexType& {
             // search simple and complex types
             const auto cit = types.types.find(name);
             if (cit != std::end(types.types)) {
                 return cit->second.as<xsd::ComplexType>();
             }
-            throw std::runtime_error("Unknown type: " + name);
+            throw std::runtime_error("Unknown type: " + name.to_string());
         }
 
         auto buildFieldListAndChoiceExpression(const xsd::SchemaTypes& types, const std::vector<std::reference_wrapper<const xsd::ComplexType>>& typeList, const Tables& tables) -> std::tuple<std::vector<Field>, ChoiceElements> {
@@ -63,15 +198,15 @@ namespace tigl {
                 // attributes
                 for (const auto& a : type.attributes) {
                     Field m;
-                    m.originXPath = a.xpath;
-                    m.cpacsName = a.name;
-                    m.xmlTypeName = a.type;
+                    m.originXPath = a.xpath.to_string();
+                    m.cpacsName = a.name.to_string();
+                    m.xmlTypeName = a.type.to_string();
                     m.typeName = resolveType(types, a.type, tables);
                     m.xmlType = XMLConstruct::Attribute;
                     m.minOccurs = a.optional ? 0 : 1;
                     m.maxOccurs = 1;
-                    m.defaultValue = a.defaultValue;
-                    m.documentation = a.documentation;
+                    m.defaultValue = a.defaultValue.to_string();
+                    m.documentation = a.documentation.to_string();
                     members.push_back(m);
                 }
 
@@ -96,20 +231,20 @@ namespace tigl {
 
                     void operator()(const xsd::Element& e) const {
                         if (e.minOccurs == 0 && e.maxOccurs == 0) {
-                            std::cerr << "Warning: Element " + e.name + " with type " + e.type + " was omitted as minOccurs and maxOccurs are both zero" << std::endl;
+                            log(LogLevel::Warning) << "Element " << e.name << " with type " << e.type << " was omitted as minOccurs and maxOccurs are both zero";
                             return; // skip this type
                         }
 
                         Field m;
-                        m.originXPath = e.xpath;
-                        m.cpacsName = e.name;
-                        m.xmlTypeName = e.type;
+                        m.originXPath = e.xpath.to_string();
+                        m.cpacsName = e.name.to_string();
+                        m.xmlTypeName = e.type.to_string();
                         m.typeName = resolveType(types, e.type, tables);
                         m.xmlType = XMLConstruct::Element;
                         m.minOccurs = e.minOccurs;
                         m.maxOccurs = e.maxOccurs;
-                        m.defaultValue = e.defaultValue;
-                        m.documentation = e.documentation;
+                        m.defaultValue = e.defaultValue.to_string();
+                        m.documentation = e.documentation.to_string();
                         emitField(std::move(m));
                     }
 
@@ -134,9 +269,10 @@ namespace tigl {
                             for (std::size_t j = i + 1; j < members.size(); j++) {
                                 const auto& f2 = members[j];
                                 if (f1.cpacsName == f2.cpacsName && (f1.cardinality() != f2.cardinality() || f1.typeName != f2.typeName)) {
-                                    std::cerr << "Elements with same name but different cardinality or type inside choice" << std::endl;
+                                    auto warning = log(LogLevel::Warning);
+                                    warning << "Elements with same name but different cardinality or type inside choice";
                                     for (const auto& f : { f1, f2 })
-                                        std::cerr << f.cpacsName << " " << toString(f.cardinality()) << " " << f.typeName << std::endl;
+                                        warning << "\n\t" << f.cpacsName << " " << toString(f.cardinality()) << " " << f.typeName;
                                 }
                             }
                         }
@@ -162,12 +298,12 @@ namespace tigl {
 
                     void operator()(const xsd::SimpleContent& g) const {
                         Field m;
-                        m.originXPath = g.xpath;
+                        m.originXPath = g.xpath.to_string();
                         m.cpacsName = "";
                         m.namePostfix = "value";
                         m.minOccurs = 1;
                         m.maxOccurs = 1;
-                        m.xmlTypeName = g.type;
+                        m.xmlTypeName = g.type.to_string();
                         m.typeName = resolveType(types, g.type, tables);
                         m.xmlType = XMLConstruct::SimpleContent;
                         emitField(std::move(m));
@@ -213,8 +349,18 @@ namespace tigl {
             : m_types(std::move(types)), tables(tables) {}
 
         void build() {
-            for (const auto& p : m_types.types) {
-                const auto& type = p.second;
+            // visit the types in name order, so types mapping to the same class name are resolved independently of hashing
+            using TypeEntry = decltype(m_types.types)::value_type;
+            std::vector<const TypeEntry*> sortedTypes;
+            sortedTypes.reserve(m_types.types.size());
+            for (const auto& p : m_types.types)
+                sortedTypes.push_back(&p);
+            std::sort(std::begin(sortedTypes), std::end(sortedTypes), [](const TypeEntry* a, const TypeEntry* b) {
+                return a->first < b->first;
+            });
+
+            for (const auto& p : sortedTypes) {
+                const auto& type = p->second;
 
                 struct TypeVisitor {
                     TypeVisitor(const xsd::SchemaTypes& types, TypeSystemBuilder& typeSystem, const Tables& tables)
@@ -222,9 +368,9 @@ namespace tigl {
 
                     void operator()(const xsd::ComplexType& type) {
                         Class c;
-                        c.originXPath = type.xpath;
-                        c.documentation = type.documentation;
-                        c.name = makeClassName(type.name);
+                        c.originXPath = type.xpath.to_string();
+                        c.documentation = type.documentation.to_string();
+                        c.name = makeClassName(type.name.to_string());
                         c.containsSequence = checkForSequence(type);
 
                         std::tie(c.fields, c.choices) = buildFieldListAndChoiceExpression(types, { type }, tables);
@@ -236,7 +382,7 @@ namespace tigl {
                             if (!c.base.empty()) {
                                 // make base a field if fundamental type
                                 if (tables.m_fundamentalTypes.contains(c.base)) {
-                                    std::cout << "\tWarning: Type " << type.name << " has base class " << c.base << " which is a fundamental type. Generated field 'base' instead" << std::endl;
+                                    log(LogLevel::Warning) << "Type " << type.name << " has base class " << c.base << " which is a fundamental type. Generated field 'base' instead";
 
                                     Field f;
                                     f.cpacsName = "";
@@ -267,13 +413,13 @@ namespace tigl {
                         if (type.restrictionValues.size() > 0) {
                             // create enum
                             Enum e;
-                            e.originXPath = type.xpath;
-                            e.name = makeClassName(type.name);
+                            e.originXPath = type.xpath.to_string();
+                            e.name = makeClassName(type.name.to_string());
                             for (const auto& v : type.restrictionValues)
-                                e.values.push_back(EnumValue(v));
+                                e.values.push_back(EnumValue(v.to_string()));
                             typeSystem.m_enums[e.name] = e;
                         } else
-                            throw NotImplementedException("Simple types which are not enums are not implemented: " + type.name);
+                            throw NotImplementedException("Simple types which are not enums are not implemented: " + type.name.to_string());
                     }
 
                 private:
@@ -286,34 +432,79 @@ namespace tigl {
             };
         }
 
-        // TODO: replace by lambda when C++14 is available
-        struct SortAndUnique {
-            template <typename T>
-            void operator()(std::vector<T*>& con) {
-                std::sort(std::begin(con), std::end(con), [](const T* a, const T* b) {
-                    return a->name < b->name;
-                });
-                con.erase(std::unique(std::begin(con), std::end(con), [](const T* a, const T* b) {
-                    return a->name == b->name;
-                }), std::end(con));
+        // moves all classes and enums into the contiguous storage of the TypeSystem, sorted by name,
+        // interns their names and resolves the type names of fields and bases to ids.
+        // Must run after the last class or enum was added or renamed
+        void flatten() {
+            auto& ts = m_typeSystem;
+
+            ts.classes.reserve(m_classes.size());
+            for (auto& p : m_classes)
+                ts.classes.push_back(std::move(p.second));
+            m_classes.clear();
+            std::sort(std::begin(ts.classes), std::end(ts.classes), [](const Class& a, const Class& b) {
+                return a.name < b.name;
+            });
+
+            ts.enums.reserve(m_enums.size());
+            for (auto& p : m_enums)
+                ts.enums.push_back(std::move(p.second));
+            m_enums.clear();
+
+            for (auto& c : ts.classes) {
+                c.id = ts.symbols.intern(c.name);
+                ts.classesById.resize(ts.symbols.size(), nullptr);
+                ts.classesById[c.id] = &c;
             }
-        };
+            for (auto& e : ts.enums) {
+                e.id = ts.symbols.intern(e.name);
+                ts.enumsById.resize(ts.symbols.size(), nullptr);
+                ts.enumsById[e.id] = &e;
+            }
+            ts.classesById.resize(ts.symbols.size(), nullptr);
+            ts.enumsById.resize(ts.symbols.size(), nullptr);
+
+            for (auto& c : ts.classes) {
+                c.baseId = c.base.empty() ? c_noTypeId : ts.symbols.find(c.base);
+                for (auto& f : c.fields)
+                    f.typeId = ts.symbols.find(f.typeName);
+            }
+        }
+
+        auto findClass(TypeId id) -> Class* {
+            return id < m_typeSystem.classesById.size() ? m_typeSystem.classesById[id] : nullptr;
+        }
+
+        auto findEnum(TypeId id) -> Enum* {
+            return id < m_typeSystem.enumsById.size() ? m_typeSystem.enumsById[id] : nullptr;
+        }
 
         void buildDependencies() {
-            std::cout << "Building dependencies" << std::endl;
+            log(LogLevel::Info) << "Building dependencies";
 
-            for (auto& p : m_classes) {
-                auto& c = p.second;
+            auto& classes = m_typeSystem.classes;
+            auto& enums = m_typeSystem.enums;
+            const auto classIndex = [&](const Class* c) {
+                return static_cast<std::size_t>(c - classes.data());
+            };
+            const auto enumIndex = [&](const Enum* e) {
+                return static_cast<std::size_t>(e - enums.data());
+            };
+
+            std::vector<std::pair<std::size_t, Class*>> bases, deriveds, parents, children, enumParents;
+            std::vector<std::pair<std::size_t, Enum*>> enumChildren;
+            for (std::size_t i = 0; i < classes.size(); i++) {
+                auto& c = classes[i];
                 if (c.pruned)
                     continue;
 
                 // base
                 if (!c.base.empty()) {
-                    const auto it = m_classes.find(c.base);
-                    if (it != std::end(m_classes)) {
-                        if (!it->second.pruned) {
-                            c.deps.bases.push_back(&it->second);
-                            it->second.deps.deriveds.push_back(&c);
+                    const auto base = findClass(c.baseId);
+                    if (base) {
+                        if (!base->pruned) {
+                            bases.emplace_back(i, base);
+                            deriveds.emplace_back(classIndex(base), &c);
                         }
                     } else
                         // this exception should be prevented by earlier code
@@ -322,126 +513,133 @@ namespace tigl {
 
                 // fields
                 for (auto& f : c.fields) {
-                    const auto eit = m_enums.find(f.typeName);
-                    if (eit != std::end(m_enums)) {
-                        if (!eit->second.pruned) {
-                            c.deps.enumChildren.push_back(&eit->second);
-                            eit->second.deps.parents.push_back(&c);
+                    if (const auto e = findEnum(f.typeId)) {
+                        if (!e->pruned) {
+                            enumChildren.emplace_back(i, e);
+                            enumParents.emplace_back(enumIndex(e), &c);
                         }
-                    } else {
-                        const auto cit = m_classes.find(f.typeName);
-                        if (cit != std::end(m_classes)) {
-                            if (!cit->second.pruned) {
-                                c.deps.children.push_back(&cit->second);
-                                cit->second.deps.parents.push_back(&c);
-                            }
+                    } else if (const auto child = findClass(f.typeId)) {
+                        if (!child->pruned) {
+                            children.emplace_back(i, child);
+                            parents.emplace_back(classIndex(child), &c);
                         }
                     }
                 }
             }
 
-            SortAndUnique sortAndUnique;
-
-            // sort and unique
-            for (auto& p : m_classes) {
-                auto& c = p.second;
-                sortAndUnique(c.deps.bases);
-                sortAndUnique(c.deps.children);
-                sortAndUnique(c.deps.deriveds);
-                sortAndUnique(c.deps.enumChildren);
-                sortAndUnique(c.deps.parents);
-            }
-
-            for (auto& p : m_enums) {
-                auto& e = p.second;
-                sortAndUnique(e.deps.parents);
+            auto& graph = m_typeSystem.dependencies;
+            buildAdjacency(graph.bases, classes.size(), std::move(bases));
+            buildAdjacency(graph.deriveds, classes.size(), std::move(deriveds));
+            buildAdjacency(graph.parents, classes.size(), std::move(parents));
+            buildAdjacency(graph.children, classes.size(), std::move(children));
+            buildAdjacency(graph.enumChildren, classes.size(), std::move(enumChildren));
+            buildAdjacency(graph.enumParents, enums.size(), std::move(enumParents));
+
+            for (std::size_t i = 0; i < classes.size(); i++) {
+                auto& deps = classes[i].deps;
+                deps.bases = graph.bases.row(i);
+                deps.deriveds = graph.deriveds.row(i);
+                deps.parents = graph.parents.row(i);
+                deps.children = graph.children.row(i);
+                deps.enumChildren = graph.enumChildren.row(i);
             }
+            for (std::size_t i = 0; i < enums.size(); i++)
+                enums[i].deps.parents = graph.enumParents.row(i);
         }
 
         void collapseEnums() {
-            std::cout << "Collapsing enums" << std::endl;
+            log(LogLevel::Info) << "Collapsing enums";
 
-            // convert enum unordered_map to vector for easier processing
-            std::vector<Enum> enumVec;
-            enumVec.reserve(m_enums.size());
-            for (const auto& p : m_enums)
-                enumVec.push_back(p.second);
+            // enums in name order, renamed in place and removed once collapsed into a preceding enum
+            std::vector<Enum*> enums;
+            std::vector<std::string> names;
+            enums.reserve(m_enums.size());
+            names.reserve(m_enums.size());
+            for (auto& p : m_enums) {
+                enums.push_back(&p.second);
+                names.push_back(p.second.name);
+            }
+            std::vector<bool> removed(enums.size(), false);
+
+            // enums can only collapse if their values and stripped names are equal, so only enums with the same key are compared
+            const auto key = [&](std::size_t i, const std::string& strippedName) {
+                Hasher h;
+                h << strippedName << enums[i]->values.size();
+                for (const auto& v : enums[i]->values)
+                    h << v.name();
+                return h.value();
+            };
+
+            std::vector<std::string> strippedNames;
+            strippedNames.reserve(enums.size());
+            std::unordered_map<std::uint64_t, std::vector<std::size_t>> groups;
+            for (std::size_t i = 0; i < enums.size(); i++) {
+                strippedNames.push_back(stripNumber(names[i]));
+                groups[key(i, strippedNames[i])].push_back(i);
+            }
 
             std::unordered_map<std::string, std::string> replacedEnums;
             std::set<std::string> replacedEnumNames;
 
-            for (std::size_t i = 0; i < enumVec.size(); i++) {
-                auto& e1 = enumVec[i];
-                for (std::size_t j = i + 1; j < enumVec.size(); j++) {
-                    auto& e2 = enumVec[j];
-
-                    auto stripNumber = [](std::string name) {
-                        // handle inline enum types
-                        // generated names are of the form: <containing type name>_<element name>[_SimpleContent][_<counter>]
-
-                        // remove optional digits and underscore at the end
-                        while (!name.empty() && std::isdigit(name.back()))
-                            name.pop_back();
-                        if (name.back() == '_')
-                            name.erase(name.length() - 1);
-                    
-                        // remove _SimpleContent
-                        name = xsd::stripSimpleContentSuffix(name);
-
-                        // if type contains an underscore, remove preceding part
-                        const auto& pos = name.find_last_of('_');
-                        if (pos != std::string::npos)
-                            name.erase(0, pos + 1);
-
-                        // capitalize first letter
-                        name[0] = std::toupper(name[0]);
-
-                        // strip Type suffix if exists
-                        name = xsd::stripTypeSuffix(name);
-
-                        // prefix CPACS if not exists
-                        if (name.compare(0, 5, "CPACS") != 0)
-                            name = "CPACS" + name;
-
-                        return name;
-                    };
-
-                    // check for equal enum values
-                    if (e1.values.size() == e2.values.size() && std::equal(std::begin(e1.values), std::end(e1.values), std::begin(e2.values))) {
-                        // strip name decorators
-                        const auto& e1StrippedName = stripNumber(e1.name);
-                        const auto& e2StrippedName = stripNumber(e2.name);
-                        if (e1StrippedName == e2StrippedName) {
-                            // choose new name
-                            const auto newName = [&] {
-                                // if the stripped name is not already taken, use it. Otherwise, take the shorter of the two enum names
-                                if (m_classes.count(e1StrippedName) == 0 && m_enums.count(e1StrippedName) == 0 && 
-                                    (replacedEnumNames.count(e1StrippedName) == 0 || e1.name == e1StrippedName || e2.name == e1StrippedName)) // ensure correct type in case stripped name was already used in previous loop run
-                                    return e1StrippedName;
-                                else
-                                    return std::min(e1.name, e2.name);
-                            }();
-
-                            // register replacements
-                            if (e1.name != newName) replacedEnums[e1.name] = newName;
-                            if (e2.name != newName) replacedEnums[e2.name] = newName;
-                            replacedEnumNames.insert(newName);
-
-                            std::cout << "\t" << e1.name << " and " << e2.name << " to " << newName << std::endl;
-
-                            // rename e1 and remove e2
-                            e1.name = newName;
-                            enumVec.erase(std::begin(enumVec) + j);
-                            j--;
+            for (std::size_t i = 0; i < enums.size(); i++) {
+                if (removed[i])
+                    continue;
+
+                // collapse all later enums with the same key into e1, in order. Renaming e1 may change its stripped name and thus its group
+                auto e1StrippedName = strippedNames[i];
+                auto groupKey = key(i, e1StrippedName);
+                std::size_t j = i;
+                while (true) {
+                    const auto& group = groups[groupKey];
+                    auto it = std::upper_bound(std::begin(group), std::end(group), j);
+                    while (it != std::end(group) && (removed[*it] || strippedNames[*it] != e1StrippedName || enums[*it]->values != enums[i]->values))
+                        ++it;
+                    if (it == std::end(group))
+                        break;
+                    j = *it;
+
+                    const auto& e1Name = names[i];
+                    const auto& e2Name = names[j];
+
+                    // choose new name
+                    const auto newName = [&] {
+                        // if the stripped name is not already taken, use it. Otherwise, take the shorter of the two enum names
+                        if (m_classes.count(e1StrippedName) == 0 && m_enums.count(e1StrippedName) == 0 &&
+                            (replacedEnumNames.count(e1StrippedName) == 0 || e1Name == e1StrippedName || e2Name == e1StrippedName)) // ensure correct type in case stripped name was already used in previous loop run
+                            return e1StrippedName;
+                        else
+                            return std::min(e1Name, e2Name);
+                    }();
+
+                    // register replacements
+                    if (e1Name != newName) replacedEnums[e1Name] = newName;
+                    if (e2Name != newName) replacedEnums[e2Name] = newName;
+                    replacedEnumNames.insert(newName);
+
+                    log(LogLevel::Debug) << "\t" << e1Name << " and " << e2Name << " to " << newName;
+
+                    // rename e1 and remove e2
+                    removed[j] = true;
+                    if (names[i] != newName) {
+                        names[i] = newName;
+                        const auto stripped = stripNumber(newName);
+                        if (stripped != e1StrippedName) {
+                            e1StrippedName = stripped;
+                            groupKey = key(i, e1StrippedName);
                         }
                     }
                 }
             }
 
-            // fill enum back again from vector
-            m_enums.clear();
-            for (auto& e : enumVec)
-                m_enums[e.name] = std::move(e);
+            // rebuild enum map from the remaining enums
+            std::map<std::string, Enum> collapsed;
+            for (std::size_t i = 0; i < enums.size(); i++) {
+                if (removed[i])
+                    continue;
+                enums[i]->name = names[i];
+                collapsed[names[i]] = std::move(*enums[i]);
+            }
+            m_enums = std::move(collapsed);
 
             // replace enum names
             for (auto& p : m_classes) {
@@ -457,8 +655,7 @@ namespace tigl {
         void prefixClashedEnumValues() {
             std::unordered_map<std::string, std::vector<Enum*>> valueToEnum;
 
-            for (auto& p : m_enums) {
-                auto& e = p.second;
+            for (auto& e : m_typeSystem.enums) {
                 if (e.pruned)
                     continue;
                 for (auto& v : e.values) {
@@ -483,158 +680,208 @@ namespace tigl {
                 }
             }
 
-            std::cout << "Prefixed the following enum values:" << std::endl;
-            for (auto& p : valueToEnum) {
+            if (!Logger::instance().enabled(LogLevel::Debug))
+                return;
+            log(LogLevel::Debug) << "Prefixed the following enum values:";
+            for (const auto& p : std::map<std::string, std::vector<Enum*>>(std::begin(valueToEnum), std::end(valueToEnum))) {
                 const auto& otherEnums = p.second;
                 if (otherEnums.size() > 1) {
-                    std::cout << '\t' << p.first << std::endl;
+                    log(LogLevel::Debug) << '\t' << p.first;
                     for (const auto& e : otherEnums)
-                        std::cout << "\t\t" << e->name << std::endl;
+                        log(LogLevel::Debug) << "\t\t" << e->name;
                 }
             }
         }
 
-        auto checkAndPrintNode(const std::string& name, const Table& pruneList, unsigned int level) {
-            if (pruneList.contains(name)) {
-                std::cout << std::string(level, '\t') <<  "pruning " << name << std::endl;
-                return true;
-            } else {
-                std::cout << std::string(level, '\t') << "including " << name << std::endl;
-                return false;
+        void runPruneList() {
+            // mark all types as pruned
+            for (auto& c : m_typeSystem.classes) {
+                c.pruned = true;
+                c.pruneDecision = PruneDecision{};
+            }
+            for (auto& e : m_typeSystem.enums) {
+                e.pruned = true;
+                e.pruneDecision = PruneDecision{};
             }
-        }
-
-        void includeNode(Enum& e, const Table& pruneList, unsigned int level) {
-            // if this enum is already marked, return
-            if (e.pruned == false)
-                return;
-
-            // if this enum is on the prune list, just leave it
-            if (checkAndPrintNode(e.name, pruneList, level))
-                return;
-
-            // enum is not pruned, mark it
-            e.pruned = false;
-        }
-
-        void includeNode(Class& cls, const Table& pruneList, unsigned int level) {
-            // if this class is already marked, return
-            if (cls.pruned == false)
-                return;
-
-
-            // if this class is on the prune list, just leave it and all its sub element types pruned
-            if (checkAndPrintNode(cls.name, pruneList, level))
-                return;
-
-            // class is not pruned, mark it
-            cls.pruned = false;
-
-            auto& deps = cls.deps;
-
-            // try to include all bases
-            for (auto& b : deps.bases)
-                includeNode(*b, pruneList, level + 1);
 
-            // try to include all field classes
-            for (auto& c : deps.children)
-                includeNode(*c, pruneList, level + 1);
+            // a class or enum to include, reached from a kept class. The root classes have no predecessor
+            struct Visit {
+                Class* cls;
+                Enum* e;
+                TypeId from;
+                std::size_t level;
+            };
+            std::vector<Visit> stack;
 
-            // try to include all field m_enums
-            for (auto& e : deps.enumChildren)
-                includeNode(*e, pruneList, level + 1);
-        }
+            // all roots are walked in one sweep. They are pushed in reverse, so they are visited in order
+            for (auto it = m_types.roots.rbegin(); it != m_types.roots.rend(); ++it) {
+                const auto rootElementTypeName = makeClassName(it->to_string());
+                const auto rootClass = findClass(m_typeSystem.symbols.find(rootElementTypeName));
+                if (!rootClass)
+                    throw std::runtime_error("Could not find root element: " + rootElementTypeName);
+                stack.push_back(Visit{ rootClass, nullptr, c_noTypeId, 0 });
+            }
 
-        void runPruneList() {
-            // mark all types as pruned
-            for (auto& p : m_classes)
-                p.second.pruned = true;
-            for (auto& p : m_enums)
-                p.second.pruned = true;
+            // depth first with an explicit stack, visiting the types in the same order as a recursion would.
+            // Types are only included once, so cycles terminate
+            const auto& pruneList = tables.m_pruneList;
+            const auto debug = Logger::instance().enabled(LogLevel::Debug);
+            while (!stack.empty()) {
+                const auto v = stack.back();
+                stack.pop_back();
+                if (v.from == c_noTypeId)
+                    log(LogLevel::Info) << "Running prune list starting at " << v.cls->name;
+
+                const auto& name = v.cls ? v.cls->name : v.e->name;
+                auto& pruned = v.cls ? v.cls->pruned : v.e->pruned;
+                auto& decision = v.cls ? v.cls->pruneDecision : v.e->pruneDecision;
+
+                // already included
+                if (!pruned)
+                    continue;
 
-            // recurse on all root nodes
-            for (const auto& root : m_types.roots) {
-                const auto rootElementTypeName = makeClassName(root);
-                std::cout << "Running prune list starting at " << rootElementTypeName << std::endl;
+                // leave types on the prune list and all their sub element types pruned
+                if (pruneList.contains(name)) {
+                    if (debug)
+                        log(LogLevel::Debug) << std::string(v.level, '\t') << "pruning " << name;
+                    if (decision.reason != PruneReason::PruneList)
+                        decision = PruneDecision{ PruneReason::PruneList, v.from };
+                    continue;
+                }
 
-                const auto it = m_classes.find(rootElementTypeName);
-                if (it == std::end(m_classes)) {
-                    throw std::runtime_error("Could not find root element: " + rootElementTypeName);
-                    return;
+                if (debug)
+                    log(LogLevel::Debug) << std::string(v.level, '\t') << "including " << name;
+                pruned = false;
+                decision = PruneDecision{ v.from == c_noTypeId ? PruneReason::Root : PruneReason::Reachable, v.from };
+
+                if (v.cls) {
+                    // bases, field classes and field enums, in reverse as the stack reverses them again
+                    const auto& deps = v.cls->deps;
+                    const auto id = v.cls->id;
+                    for (auto it = deps.enumChildren.end(); it != deps.enumChildren.begin();)
+                        stack.push_back(Visit{ nullptr, *--it, id, v.level + 1 });
+                    for (auto it = deps.children.end(); it != deps.children.begin();)
+                        stack.push_back(Visit{ *--it, nullptr, id, v.level + 1 });
+                    for (auto it = deps.bases.end(); it != deps.bases.begin();)
+                        stack.push_back(Visit{ *--it, nullptr, id, v.level + 1 });
                 }
+            }
 
-                includeNode(it->second, tables.m_pruneList, 0);
+            if (Logger::instance().enabled(LogLevel::Debug)) {
+                log(LogLevel::Debug) << "The following types have been pruned:";
+                std::vector<std::string> prunedTypeNames;
+                for (const auto& c : m_typeSystem.classes)
+                    if(c.pruned)
+                        prunedTypeNames.push_back("Class: " + c.name);
+                for (const auto& e : m_typeSystem.enums)
+                    if (e.pruned)
+                        prunedTypeNames.push_back("Enum: " + e.name);
+                std::sort(std::begin(prunedTypeNames), std::end(prunedTypeNames));
+                for(const auto& name : prunedTypeNames)
+                    log(LogLevel::Debug) << "\t" << name;
             }
 
-            std::cout << "The following types have been pruned:" << std::endl;
-            std::vector<std::string> prunedTypeNames;
-            for (const auto& p : m_classes)
-                if(p.second.pruned)
-                    prunedTypeNames.push_back("Class: " + p.second.name);
-            for (const auto& p : m_enums)
-                if (p.second.pruned)
-                    prunedTypeNames.push_back("Enum: " + p.second.name);
-            std::sort(std::begin(prunedTypeNames), std::end(prunedTypeNames));
-            for(const auto& name : prunedTypeNames)
-                std::cout << "\t" << name << std::endl;
-
-            auto isPruned = [&](const std::string& name) {
-                const auto& cit = m_classes.find(name);
-                if (cit != std::end(m_classes) && cit->second.pruned)
+            auto isPruned = [&](TypeId id) {
+                const auto c = findClass(id);
+                if (c && c->pruned)
                     return true;
-                const auto& eit = m_enums.find(name);
-                if (eit != std::end(m_enums) && eit->second.pruned)
+                const auto e = findEnum(id);
+                if (e && e->pruned)
                     return true;
                 return false;
             };
 
             // remove pruned classes and enums from class fields and bases
-            for (auto& c : m_classes) {
-                auto& fields = c.second.fields;
+            for (auto& c : m_typeSystem.classes) {
+                auto& fields = c.fields;
                 fields.erase(std::remove_if(std::begin(fields), std::end(fields), [&](const Field& f) {
-                    return isPruned(f.typeName);
+                    return isPruned(f.typeId);
                 }), std::end(fields));
 
-                auto& baseName = c.second.base;
-                if (isPruned(baseName))
-                    baseName.clear();
+                if (isPruned(c.baseId)) {
+                    c.base.clear();
+                    c.baseId = c_noTypeId;
+                }
             }
 
-            // clear and rebuild dependencies
-            for (auto& c : m_classes)
-                c.second.deps = ClassDependencies{};
-            for (auto& e : m_enums)
-                e.second.deps = EnumDependencies{};
+            // rebuild dependencies
             buildDependencies();
         }
 
+        void analyzeUidManagerRequirements() {
+            const auto hasUidField = [](const Class& c) {
+                return std::any_of(std::begin(c.fields), std::end(c.fields), [](const Field& f) {
+                    return f.name() == "uID";
+                });
+            };
+            const auto hasUidOrUidRefField = [&](const Class& c) {
+                return hasUidField(c) || std::any_of(std::begin(c.fields), std::end(c.fields), [](const Field& f) {
+                    return f.xmlTypeName == c_uidRefType;
+                });
+            };
+
+            auto& classes = m_typeSystem.classes;
+            const auto& graph = m_typeSystem.dependencies;
+            const auto uidInHierarchy = reachesAny(classes, { &graph.bases }, hasUidField);
+            const auto requiresUidManager = reachesAny(classes, { &graph.bases, &graph.children }, hasUidOrUidRefField);
+
+            for (std::size_t i = 0; i < classes.size(); i++) {
+                auto& c = classes[i];
+                c.requiresUidManager = requiresUidManager[i];
+                c.hasInheritedUidField = std::any_of(std::begin(c.deps.bases), std::end(c.deps.bases), [&](const Class* b) {
+                    return uidInHierarchy[b - classes.data()];
+                });
+            }
+        }
+
         const Tables& tables;
         xsd::SchemaTypes m_types;
+        // classes and enums by name until they are flattened into m_typeSystem
         std::unordered_map<std::string, Class> m_classes;
         std::map<std::string, Enum> m_enums;
+
+        TypeSystem m_typeSystem;
     };
 
+    auto SymbolTable::intern(const std::string& name) -> TypeId {
+        const auto r = m_ids.insert(std::make_pair(name, static_cast<TypeId>(m_names.size())));
+        if (r.second)
+            m_names.push_back(&r.first->first);
+        return r.first->second;
+    }
+
+    auto SymbolTable::find(const std::string& name) const -> TypeId {
+        const auto it = m_ids.find(name);
+        return it != std::end(m_ids) ? it->second : c_noTypeId;
+    }
+
+    auto SymbolTable::name(TypeId id) const -> const std::string& {
+        return *m_names.at(id);
+    }
+
+    auto SymbolTable::size() const -> std::size_t {
+        return m_names.size();
+    }
+
     auto buildTypeSystem(xsd::SchemaTypes types, const Tables& tables) -> TypeSystem {
         TypeSystemBuilder builder(std::move(types), tables);
-        builder.build();
-        builder.collapseEnums();
-        builder.buildDependencies();
-        builder.runPruneList();
-        builder.prefixClashedEnumValues();
-        return {
-            std::move(builder.m_classes),
-            std::move(builder.m_enums)
-        };
+        { ProfilePhase phase("build");                         builder.build(); }
+        { ProfilePhase phase("collapseEnums");                 builder.collapseEnums(); }
+        { ProfilePhase phase("flatten");                       builder.flatten(); }
+        { ProfilePhase phase("buildDependencies");             builder.buildDependencies(); }
+        { ProfilePhase phase("runPruneList");                  builder.runPruneList(); }
+        { ProfilePhase phase("prefixClashedEnumValues");       builder.prefixClashedEnumValues(); }
+        { ProfilePhase phase("analyzeUidManagerRequirements"); builder.analyzeUidManagerRequirements(); }
+        return std::move(builder.m_typeSystem);
     }
 
     void writeGraphVisFile(const TypeSystem& ts, const std::string& typeSystemGraphVisFile) {
-        std::cout << "Writing type system graph vis file to " << typeSystemGraphVisFile << std::endl;
+        log(LogLevel::Info) << "Writing type system graph vis file to " << typeSystemGraphVisFile;
         std::ofstream f{typeSystemGraphVisFile};
         if (!f)
             throw std::runtime_error("Failed to open file " + typeSystemGraphVisFile + " for writing");
         f << "digraph typesystem {\n";
-        for (const auto& p : ts.classes) {
-            const auto& c = p.second;
+        for (const auto& c : ts.classes) {
             if (c.pruned)
                 continue;
             for (const auto& b : c.deps.bases)
@@ -1,7 +1,9 @@
 #pragma once
 
-#include <boost/variant/recursive_wrapper.hpp>
+#include <boost/variant.hpp>
 
+#include <cstdint>
+#include <limits>
 #include <map>
 #include <string>
 #include <unordered_map>
@@ -11,10 +13,14 @@
 
 #include "Variant.hpp"
 #include "SchemaParser.h"
+#include "Span.h"
 
 namespace tigl {
     const auto c_allTypesGetParentPointer = true;
 
+    // xsd type of the fields referring to other objects by uID, shared by the uid manager analysis and the code generator
+    const auto c_uidRefType = "stringUIDBaseType";
+
     class Tables;
 
     enum class Cardinality {
@@ -42,11 +48,35 @@ namespace tigl {
     struct Class;
     struct Enum;
 
+    // index of an interned type name, only valid within the TypeSystem it was created by
+    using TypeId = std::uint32_t;
+    const auto c_noTypeId = std::numeric_limits<TypeId>::max();
+
+    // interns strings, assigning consecutive ids starting at 0
+    class SymbolTable {
+    public:
+        SymbolTable() = default;
+        SymbolTable(const SymbolTable&) = delete;
+        SymbolTable& operator=(const SymbolTable&) = delete;
+        SymbolTable(SymbolTable&&) = default;
+        SymbolTable& operator=(SymbolTable&&) = default;
+
+        auto intern(const std::string& name) -> TypeId;
+        auto find(const std::string& name) const -> TypeId; // c_noTypeId if name was not interned
+        auto name(TypeId id) const -> const std::string&;
+        auto size() const -> std::size_t;
+
+    private:
+        std::unordered_map<std::string, TypeId> m_ids;
+        std::vector<const std::string*> m_names; // keys of m_ids
+    };
+
     struct Field {
         std::string originXPath;
         std::string cpacsName;
         std::string xmlTypeName;
         std::string typeName;
+        TypeId typeId = c_noTypeId; // set by buildTypeSystem if typeName is a class or enum
         XMLConstruct xmlType;
         unsigned int minOccurs = 0;
         unsigned int maxOccurs = 0;
@@ -82,16 +112,52 @@ namespace tigl {
         }
     };
 
-    // non owning
+    // edges of one relation in compressed sparse row layout. The targets of node i are targets[offsets[i]] up to targets[offsets[i + 1]]
+    template <typename T>
+    struct Adjacency {
+        std::vector<std::size_t> offsets;
+        std::vector<T*> targets;
+
+        auto row(std::size_t i) const -> Span<T* const> {
+            if (i + 1 >= offsets.size())
+                return {};
+            return { targets.data() + offsets[i], targets.data() + offsets[i + 1] };
+        }
+    };
+
+    // non owning, views into the DependencyGraph of the TypeSystem
     struct ClassDependencies {
         // in the context of inheritance
-        std::vector<Class*> bases;
-        std::vector<Class*> deriveds;
+        Span<Class* const> bases;
+        Span<Class* const> deriveds;
 
         // in the context of the XML tree
-        std::vector<Class*> parents;
-        std::vector<Class*> children;
-        std::vector<Enum*> enumChildren;
+        Span<Class* const> parents;
+        Span<Class* const> children;
+        Span<Enum* const> enumChildren;
+    };
+
+    // why runPruneList kept or pruned a class or enum
+    enum class PruneReason {
+        Root,        // kept, the type of a root element
+        Reachable,   // kept, referenced by reachedFrom
+        PruneList,   // pruned, listed in the prune list. reachedFrom is the first kept type referencing it, none for a root
+        Unreachable  // pruned, only reachable from a root through types on the prune list, if at all
+    };
+
+    inline auto toString(const PruneReason& r) -> std::string {
+        switch (r) {
+            case PruneReason::Root:        return "Root";
+            case PruneReason::Reachable:   return "Reachable";
+            case PruneReason::PruneList:   return "PruneList";
+            case PruneReason::Unreachable: return "Unreachable";
+            default: throw std::logic_error("No toString defined");
+        }
+    }
+
+    struct PruneDecision {
+        PruneReason reason = PruneReason::Unreachable;
+        TypeId reachedFrom = c_noTypeId;
     };
 
     struct ChoiceElement {
@@ -110,11 +176,18 @@ namespace tigl {
     struct Class {
         std::string originXPath;
         std::string name;
+        TypeId id = c_noTypeId;
         std::string base;
+        TypeId baseId = c_noTypeId;
         std::vector<Field> fields;
         ChoiceElements choices;
         bool containsSequence;
         bool pruned = false;
+        PruneDecision pruneDecision; // set by runPruneList
+
+        // computed by buildTypeSystem from the final dependencies
+        bool requiresUidManager = false;   // the class or any class reachable via its bases and children has a uid or uid reference field
+        bool hasInheritedUidField = false; // any of its direct or indirect bases has a uid field
 
         std::string documentation;
 
@@ -142,21 +215,56 @@ namespace tigl {
     };
 
     struct EnumDependencies {
-        std::vector<Class*> parents;
+        Span<Class* const> parents;
     };
 
     struct Enum {
         std::string originXPath;
         std::string name;
+        TypeId id = c_noTypeId;
         std::vector<EnumValue> values;
         bool pruned = false;
+        PruneDecision pruneDecision; // set by runPruneList
 
         EnumDependencies deps;
     };
 
+    // all dependency edges, indexed by the position of the class or enum in the TypeSystem
+    struct DependencyGraph {
+        Adjacency<Class> bases;
+        Adjacency<Class> deriveds;
+        Adjacency<Class> parents;
+        Adjacency<Class> children;
+        Adjacency<Enum> enumChildren;
+        Adjacency<Class> enumParents;
+    };
+
+    // owns all classes and enums in contiguous storage, sorted by name. Pointers to classes and enums stay valid when the TypeSystem is moved
     struct TypeSystem {
-        std::unordered_map<std::string, Class> classes;
-        std::map<std::string, Enum> enums;
+        std::vector<Class> classes;
+        std::vector<Enum> enums;
+        DependencyGraph dependencies;
+
+        // names of all classes and enums. Lookups by id are array accesses instead of hashing the name
+        SymbolTable symbols;
+        std::vector<Class*> classesById; // nullptr if the id refers to an enum
+        std::vector<Enum*> enumsById;    // nullptr if the id refers to a class
+
+        auto findClass(TypeId id) const -> const Class* {
+            return id < classesById.size() ? classesById[id] : nullptr;
+        }
+
+        auto findEnum(TypeId id) const -> const Enum* {
+            return id < enumsById.size() ? enumsById[id] : nullptr;
+        }
+
+        auto findClass(const std::string& name) const -> const Class* {
+            return findClass(symbols.find(name));
+        }
+
+        auto findEnum(const std::string& name) const -> const Enum* {
+            return findEnum(symbols.find(name));
+        }
     };
 
     auto buildTypeSystem(xsd::SchemaTypes types, const Tables& tables) -> TypeSystem;
@@ -1,92 +1,194 @@
 #pragma once
 
-#include <boost/variant.hpp>
-#include <boost/optional.hpp>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace tigl {
+    namespace detail {
+        // index of T in Ts..., sizeof...(Ts) if T is not contained
+        template <typename T, typename... Ts>
+        struct IndexOf;
+
+        template <typename T>
+        struct IndexOf<T> : std::integral_constant<std::size_t, 0> {};
+
+        template <typename T, typename... Ts>
+        struct IndexOf<T, T, Ts...> : std::integral_constant<std::size_t, 0> {};
+
+        template <typename T, typename U, typename... Ts>
+        struct IndexOf<T, U, Ts...> : std::integral_constant<std::size_t, 1 + IndexOf<T, Ts...>::value> {};
+
+        template <bool... Bs>
+        struct AllOf : std::true_type {};
+
+        template <bool B, bool... Bs>
+        struct AllOf<B, Bs...> : std::integral_constant<bool, B && AllOf<Bs...>::value> {};
+    }
+
+    // tagged union of Ts, which may also be empty.
+    // The held type is stored as index into Ts, is<T>() is a single comparison and visit dispatches through a table of functions
     template <typename... Ts>
     class Variant {
+        template <typename T>
+        using IndexOf = detail::IndexOf<typename std::decay<T>::type, Ts...>;
+
+        template <typename T>
+        using EnableIfAlternative = typename std::enable_if<(IndexOf<T>::value < sizeof...(Ts))>::type;
+
+        static constexpr auto c_empty = sizeof...(Ts);
+
+        static constexpr bool c_nothrowMove = detail::AllOf<std::is_nothrow_move_constructible<Ts>::value...>::value;
+
     public:
-        Variant() {}
+        Variant() noexcept {}
 
-        template<typename T>
-        Variant(const T& t) {
-            m_data = t;
+        template <typename T, typename = EnableIfAlternative<T>>
+        Variant(T&& t) {
+            construct(std::forward<T>(t));
         }
 
         Variant(const Variant& other) {
-            m_data = other.m_data;
+            copyFrom(other);
         }
 
-        Variant& operator=(const Variant& other) {
-            m_data = other.m_data;
-            return *this;
+        Variant(Variant&& other) noexcept(c_nothrowMove) {
+            moveFrom(other);
         }
 
-        Variant(Variant&& other) {
-            m_data = std::move(other.m_data);
+        ~Variant() {
+            destroy();
         }
 
-        Variant& operator=(Variant&& other) {
-            m_data = std::move(other.m_data);
+        Variant& operator=(const Variant& other) {
+            if (this != &other) {
+                destroy();
+                copyFrom(other);
+            }
             return *this;
         }
 
-        template<typename T>
-        Variant& operator=(const T& t) {
-            m_data = t;
+        Variant& operator=(Variant&& other) noexcept(c_nothrowMove) {
+            if (this != &other) {
+                destroy();
+                moveFrom(other);
+            }
+            return *this;
+        }
+
+        template <typename T, typename = EnableIfAlternative<T>>
+        Variant& operator=(T&& t) {
+            using U = typename std::decay<T>::type;
+            // t may refer to the held value or a part of it, e.g. v = v.as<A>(), which must not be destroyed before it is read
+            if (m_index == IndexOf<T>::value) {
+                *reinterpret_cast<U*>(&m_storage) = std::forward<T>(t);
+            } else {
+                U value(std::forward<T>(t));
+                destroy();
+                construct(std::move(value));
+            }
             return *this;
         }
 
         template<typename Visitor>
         void visit(Visitor func) {
-            if (m_data) {
-                VisitorWrapper<Visitor> visitor(func);
-                m_data->apply_visitor(visitor);
+            if (m_index != c_empty) {
+                static constexpr void (*table[])(void*, Visitor&) = { &invoke<Ts, Visitor>... };
+                table[m_index](&m_storage, func);
             }
         }
 
         template<typename Visitor>
         void visit(Visitor func) const {
-            if (m_data) {
-                VisitorWrapper<Visitor> visitor(func);
-                m_data->apply_visitor(visitor);
+            if (m_index != c_empty) {
+                static constexpr void (*table[])(const void*, Visitor&) = { &invokeConst<Ts, Visitor>... };
+                table[m_index](&m_storage, func);
             }
         }
 
         template<typename T>
-        bool is() const {
-            if (m_data)
-                return m_data->type() == typeid(T);
-            return false;
+        bool is() const noexcept {
+            return m_index == IndexOf<T>::value;
         }
 
         template<typename T>
         T& as() {
-            return boost::get<T&>(*m_data);
+            check<T>();
+            return *reinterpret_cast<T*>(&m_storage);
         }
 
         template<typename T>
         const T& as() const {
-            return boost::get<const T&>(*m_data);
+            check<T>();
+            return *reinterpret_cast<const T*>(&m_storage);
         }
 
     private:
-        // adapts a visitor for boost
-        template <typename Func>
-        struct VisitorWrapper : public boost::static_visitor<> {
-            VisitorWrapper(Func func)
-                : m_func(func) {}
-
-            template<typename T>
-            void operator()(T&& arg) {
-                m_func(std::forward<T>(arg));
+        template <typename T, typename Visitor>
+        static void invoke(void* p, Visitor& func) {
+            func(*static_cast<T*>(p));
+        }
+
+        template <typename T, typename Visitor>
+        static void invokeConst(const void* p, Visitor& func) {
+            func(*static_cast<const T*>(p));
+        }
+
+        template <typename T>
+        static void copyConstruct(void* p, const void* other) {
+            new (p) T(*static_cast<const T*>(other));
+        }
+
+        template <typename T>
+        static void moveConstruct(void* p, void* other) {
+            new (p) T(std::move(*static_cast<T*>(other)));
+        }
+
+        template <typename T>
+        static void destruct(void* p) {
+            static_cast<T*>(p)->~T();
+        }
+
+        template <typename T>
+        void check() const {
+            if (m_index != IndexOf<T>::value)
+                throw std::logic_error("Variant does not hold the requested type");
+        }
+
+        template <typename T>
+        void construct(T&& t) {
+            using U = typename std::decay<T>::type;
+            new (&m_storage) U(std::forward<T>(t));
+            m_index = IndexOf<T>::value;
+        }
+
+        void copyFrom(const Variant& other) {
+            if (other.m_index != c_empty) {
+                static constexpr void (*table[])(void*, const void*) = { &copyConstruct<Ts>... };
+                table[other.m_index](&m_storage, &other.m_storage);
+                m_index = other.m_index;
+            }
+        }
+
+        void moveFrom(Variant& other) noexcept(c_nothrowMove) {
+            if (other.m_index != c_empty) {
+                static constexpr void (*table[])(void*, void*) = { &moveConstruct<Ts>... };
+                table[other.m_index](&m_storage, &other.m_storage);
+                m_index = other.m_index;
             }
+        }
 
-        private:
-            Func m_func;
-        };
+        void destroy() noexcept {
+            if (m_index != c_empty) {
+                static constexpr void (*table[])(void*) = { &destruct<Ts>... };
+                table[m_index](&m_storage);
+                m_index = c_empty;
+            }
+        }
 
-        boost::optional<boost::variant<Ts...>> m_data;
+        typename std::aligned_union<0, Ts...>::type m_storage;
+        std::size_t m_index = c_empty;
     };
 }
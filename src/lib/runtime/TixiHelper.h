@@ -23,10 +23,20 @@
     #define BOOST_DATE_TIME_NO_LIB
 #endif
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/optional.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
 #include <ctime>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "UniquePtr.h"
 #ifndef CPACS_GEN
@@ -36,6 +46,384 @@
 // some extensions to tixi
 namespace tixi
 {
+    // XPath parsed into its steps, e.g. "/cpacs/vehicles/aircraft/model[2]/@uID", which the TixiElementIndex looks up.
+    // Only child element steps with an optional position and a trailing attribute are supported,
+    // other expressions are evaluated by TIXI
+    class TixiCompiledXPath
+    {
+    public:
+        struct Step
+        {
+            std::string name;
+            int index; // 0 for all elements with the name
+        };
+
+        explicit TixiCompiledXPath(const std::string& relativeXPath)
+            : m_xpath(relativeXPath), m_supported(true)
+        {
+            std::size_t begin = relativeXPath.empty() || relativeXPath[0] != '/' ? 0 : 1;
+            while (m_supported && begin < relativeXPath.size()) {
+                auto end = relativeXPath.find('/', begin);
+                if (end == std::string::npos) {
+                    end = relativeXPath.size();
+                }
+                parseStep(relativeXPath.substr(begin, end - begin), end == relativeXPath.size());
+                begin = end + 1;
+            }
+            m_supported = m_supported && (!m_steps.empty() || !m_attribute.empty());
+        }
+
+        const std::string& xpath() const
+        {
+            return m_xpath;
+        }
+
+        bool supported() const
+        {
+            return m_supported;
+        }
+
+        const std::vector<Step>& steps() const
+        {
+            return m_steps;
+        }
+
+        // empty if the expression selects elements
+        const std::string& attribute() const
+        {
+            return m_attribute;
+        }
+
+    private:
+        void parseStep(const std::string& step, bool last)
+        {
+            // XML names, which excludes the steps . and ..
+            auto isName = [](const std::string& str) {
+                return !str.empty() && (std::isalpha(static_cast<unsigned char>(str[0])) || str[0] == '_') && std::all_of(str.begin(), str.end(), [](char c) {
+                    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '-' || c == '.' || c == ':';
+                });
+            };
+            if (last && !step.empty() && step[0] == '@') {
+                m_attribute = step.substr(1);
+                m_supported = isName(m_attribute);
+                return;
+            }
+            const auto bracket = step.find('[');
+            Step s{step.substr(0, bracket), 0};
+            if (bracket != std::string::npos) {
+                const auto number = step.substr(bracket + 1, step.size() - bracket - 2);
+                if (step.back() != ']' || number.empty() || !std::all_of(number.begin(), number.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; })) {
+                    m_supported = false;
+                    return;
+                }
+                // longer positions may not fit into an int
+                if (number.size() > static_cast<std::size_t>(std::numeric_limits<int>::digits10)) {
+                    m_supported = false;
+                    return;
+                }
+                s.index = std::stoi(number);
+                m_supported = s.index > 0;
+            }
+            m_supported = m_supported && isName(s.name);
+            m_steps.push_back(s);
+        }
+
+        std::string m_xpath;
+        bool m_supported;
+        std::vector<Step> m_steps;
+        std::string m_attribute;
+    };
+
+    // index of all elements of a document by their canonical path, in which every step has a position, e.g. /cpacs[1]/header[1].
+    // Holds the attribute names and child element counts of each element, so checking for and counting elements and attributes
+    // are hash lookups instead of XPath evaluations. Values are not indexed, TIXI only reads them through an XPath.
+    // Opt-in per document, see TixiElementIndexScope
+    class TixiElementIndex
+    {
+    public:
+        // walks the document below rootXPath, e.g. "/cpacs", once.
+        // Every element costs a TixiGetAttributeNames and a TixiGetNumberOfChilds call and every child node a TixiGetChildNodeName call,
+        // each evaluating the canonical path of the element. As TIXI counts up to the requested child, an element with n child nodes takes O(n^2) steps.
+        // See benchmarks --element-index for the build time compared to reading without the index
+        TixiElementIndex(const TixiDocumentHandle& tixiHandle, const std::string& rootXPath)
+        {
+            const TixiCompiledXPath root(rootXPath);
+            if (!root.supported() || root.steps().size() != 1 || !root.attribute().empty() || root.steps()[0].index > 1) {
+                throw std::invalid_argument("The root of an element index must be a single element, e.g. /cpacs, got " + rootXPath);
+            }
+            m_rootName = root.steps()[0].name;
+
+            // with an explicit stack instead of recursion, the depth of the document is not limited by the call stack
+            std::vector<std::string> pending(1, "/" + m_rootName + "[1]");
+            while (!pending.empty()) {
+                const std::string key = std::move(pending.back());
+                pending.pop_back();
+                Element element = read(tixiHandle, key);
+                for (const auto& c : element.childCounts) {
+                    for (int i = 1; i <= c.second; i++) {
+                        pending.push_back(key + "/" + c.first + "[" + std::to_string(i) + "]");
+                    }
+                }
+                m_elements.emplace(key, std::move(element));
+            }
+        }
+
+        struct Element
+        {
+            std::vector<std::string> attributes;
+            std::vector<std::pair<std::string, int>> childCounts; // in order of first occurrence
+
+            int childCount(const std::string& name) const
+            {
+                for (const auto& c : childCounts) {
+                    if (c.first == name) {
+                        return c.second;
+                    }
+                }
+                return 0;
+            }
+        };
+
+        // number of elements matching the absolute xpath, boost::none if xpath is not supported by the index
+        boost::optional<int> count(const std::string& xpath, int limit = std::numeric_limits<int>::max()) const
+        {
+            const TixiCompiledXPath compiled(xpath);
+            if (!compiled.supported() || compiled.steps().empty() || xpath[0] != '/') {
+                return boost::none;
+            }
+            const auto& root = compiled.steps()[0];
+            if (root.name != m_rootName || root.index > 1) {
+                return 0;
+            }
+            return countMatches(compiled, "/" + m_rootName + "[1]", 1, limit);
+        }
+
+        boost::optional<bool> checkElement(const std::string& xpath) const
+        {
+            const auto c = count(xpath, 1);
+            if (!c) {
+                return boost::none;
+            }
+            return *c > 0;
+        }
+
+        boost::optional<bool> checkAttribute(const std::string& xpath, const std::string& attribute) const
+        {
+            return checkElement(xpath + "/@" + attribute);
+        }
+
+        // the element at xpath if it is unique, nullptr if xpath is not supported or matches no or multiple elements
+        const Element* find(const std::string& xpath) const
+        {
+            const TixiCompiledXPath compiled(xpath);
+            if (!compiled.supported() || compiled.steps().empty() || !compiled.attribute().empty() || xpath[0] != '/') {
+                return nullptr;
+            }
+            const auto& root = compiled.steps()[0];
+            if (root.name != m_rootName || root.index > 1) {
+                return nullptr;
+            }
+            std::string key = "/" + m_rootName + "[1]";
+            const Element* element = lookup(key);
+            for (std::size_t i = 1; i < compiled.steps().size() && element; i++) {
+                const auto& s = compiled.steps()[i];
+                const auto count = element->childCount(s.name);
+                if ((s.index == 0 && count != 1) || s.index > count) {
+                    return nullptr;
+                }
+                key += "/" + s.name + "[" + std::to_string(s.index == 0 ? 1 : s.index) + "]";
+                element = lookup(key);
+            }
+            return element;
+        }
+
+        std::size_t size() const
+        {
+            return m_elements.size();
+        }
+
+    private:
+        static Element read(const TixiDocumentHandle& tixiHandle, const std::string& key)
+        {
+            Element element;
+            element.attributes = TixiGetAttributeNames(tixiHandle, key);
+            const int count = TixiGetNumberOfChilds(tixiHandle, key);
+            for (int i = 1; i <= count; i++) {
+                const auto name = TixiGetChildNodeName(tixiHandle, key, i);
+                if (name.empty() || name[0] == '#') {
+                    continue; // text, comments and cdata
+                }
+                const auto it = std::find_if(element.childCounts.begin(), element.childCounts.end(), [&](const std::pair<std::string, int>& c) {
+                    return c.first == name;
+                });
+                if (it != element.childCounts.end()) {
+                    it->second++;
+                } else {
+                    element.childCounts.emplace_back(name, 1);
+                }
+            }
+            return element;
+        }
+
+        const Element* lookup(const std::string& key) const
+        {
+            const auto it = m_elements.find(key);
+            return it != m_elements.end() ? &it->second : nullptr;
+        }
+
+        int countMatches(const TixiCompiledXPath& xpath, const std::string& key, std::size_t step, int limit) const
+        {
+            const auto element = lookup(key);
+            if (!element) {
+                return 0;
+            }
+            if (step == xpath.steps().size()) {
+                const auto& a = xpath.attribute();
+                return a.empty() || std::find(element->attributes.begin(), element->attributes.end(), a) != element->attributes.end() ? 1 : 0;
+            }
+            const auto& s = xpath.steps()[step];
+            const auto count = element->childCount(s.name);
+            if (step + 1 == xpath.steps().size() && xpath.attribute().empty()) {
+                return s.index > 0 ? (s.index <= count ? 1 : 0) : std::min(count, limit);
+            }
+            if (s.index > 0) {
+                return s.index <= count ? countMatches(xpath, key + "/" + s.name + "[" + std::to_string(s.index) + "]", step + 1, limit) : 0;
+            }
+            int matches = 0;
+            for (int i = 1; i <= count && matches < limit; i++) {
+                matches += countMatches(xpath, key + "/" + s.name + "[" + std::to_string(i) + "]", step + 1, limit - matches);
+            }
+            return matches;
+        }
+
+        std::string m_rootName;
+        std::unordered_map<std::string, Element> m_elements;
+    };
+
+    namespace internal
+    {
+        // element indices of the documents they were enabled for
+        class TixiElementIndexRegistry
+        {
+        public:
+            static TixiElementIndexRegistry& instance()
+            {
+                static TixiElementIndexRegistry registry;
+                return registry;
+            }
+
+            void set(const TixiDocumentHandle& tixiHandle, std::shared_ptr<const TixiElementIndex> index)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (index) {
+                    m_indices[tixiHandle] = std::move(index);
+                } else {
+                    m_indices.erase(tixiHandle);
+                }
+                m_empty = m_indices.empty();
+            }
+
+            std::shared_ptr<const TixiElementIndex> get(const TixiDocumentHandle& tixiHandle) const
+            {
+                // avoid locking when no index is enabled, which is the common case
+                if (m_empty) {
+                    return nullptr;
+                }
+                std::lock_guard<std::mutex> lock(m_mutex);
+                const auto it = m_indices.find(tixiHandle);
+                return it != m_indices.end() ? it->second : nullptr;
+            }
+
+        private:
+            mutable std::mutex m_mutex;
+            std::unordered_map<TixiDocumentHandle, std::shared_ptr<const TixiElementIndex>> m_indices;
+            std::atomic<bool> m_empty{true};
+        };
+    }
+
+    // builds an element index of the document below rootXPath, e.g. "/cpacs", which the runtime functions use until it is disabled or invalidated.
+    // Meant for reading a whole model, prefer a TixiElementIndexScope around the ReadCPACS calls of the root classes
+    inline void TixiEnableElementIndex(const TixiDocumentHandle& tixiHandle, const std::string& rootXPath)
+    {
+        internal::TixiElementIndexRegistry::instance().set(tixiHandle, std::make_shared<const TixiElementIndex>(tixiHandle, rootXPath));
+    }
+
+    inline void TixiDisableElementIndex(const TixiDocumentHandle& tixiHandle)
+    {
+        internal::TixiElementIndexRegistry::instance().set(tixiHandle, nullptr);
+    }
+
+    // the element index of the document, nullptr if none is enabled
+    inline std::shared_ptr<const TixiElementIndex> TixiGetElementIndex(const TixiDocumentHandle& tixiHandle)
+    {
+        return internal::TixiElementIndexRegistry::instance().get(tixiHandle);
+    }
+
+    // drops the element index of the document. Called by the *Indexed variants of the functions modifying the document below,
+    // which all functions of the runtime modifying the document write through.
+    // The index is not updated, as its canonical paths shift with every inserted or removed element
+    inline void TixiInvalidateElementIndex(const TixiDocumentHandle& tixiHandle)
+    {
+        if (TixiGetElementIndex(tixiHandle)) {
+            TixiDisableElementIndex(tixiHandle);
+        }
+    }
+
+    // enables the element index of a document while it is alive, e.g. around reading the whole model.
+    // Changes made through tixicpp or the TIXI C API directly are not noticed by the index, so they must not happen within the scope
+    class TixiElementIndexScope
+    {
+    public:
+        TixiElementIndexScope(const TixiDocumentHandle& tixiHandle, const std::string& rootXPath)
+            : m_handle(tixiHandle)
+        {
+            TixiEnableElementIndex(tixiHandle, rootXPath);
+        }
+
+        ~TixiElementIndexScope()
+        {
+            TixiDisableElementIndex(m_handle);
+        }
+
+        TixiElementIndexScope(const TixiElementIndexScope&) = delete;
+        TixiElementIndexScope& operator=(const TixiElementIndexScope&) = delete;
+
+    private:
+        TixiDocumentHandle m_handle;
+    };
+
+    // like TixiCheckElement and TixiCheckAttribute, but answered by the element index of the document if one is enabled
+    inline bool TixiCheckElementIndexed(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
+    {
+        if (const auto index = TixiGetElementIndex(tixiHandle)) {
+            if (const auto exists = index->checkElement(xpath)) {
+                return *exists;
+            }
+        }
+        return TixiCheckElement(tixiHandle, xpath);
+    }
+
+    inline bool TixiCheckAttributeIndexed(const TixiDocumentHandle& tixiHandle, const std::string& xpath, const std::string& attribute)
+    {
+        if (const auto index = TixiGetElementIndex(tixiHandle)) {
+            if (const auto exists = index->checkAttribute(xpath, attribute)) {
+                return *exists;
+            }
+        }
+        return TixiCheckAttribute(tixiHandle, xpath, attribute);
+    }
+
+    // like TixiGetNamedChildrenCount, but answered by the element index of the document if one is enabled
+    inline int TixiGetNamedChildrenCountIndexed(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
+    {
+        if (const auto index = TixiGetElementIndex(tixiHandle)) {
+            if (const auto count = index->count(xpath)) {
+                return *count;
+            }
+        }
+        return TixiGetNamedChildrenCount(tixiHandle, xpath);
+    }
+
     inline std::time_t TixiGetTimeTElement(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         return boost::posix_time::to_time_t(boost::posix_time::from_iso_extended_string(TixiGetTextElement(tixiHandle, xpath)));
@@ -52,13 +440,228 @@ namespace tixi
         TixiSaveElement(tixiHandle, xpath, boost::posix_time::to_iso_extended_string(boost::posix_time::from_time_t(value)));
     }
 
+    inline std::time_t TixiGetTimeTAttribute(const TixiDocumentHandle& tixiHandle, const std::string& xpath, const std::string& attribute)
+    {
+        return boost::posix_time::to_time_t(boost::posix_time::from_iso_extended_string(TixiGetTextAttribute(tixiHandle, xpath, attribute)));
+    }
+
+    template<>
+    inline std::time_t TixiGetAttribute<std::time_t>(const TixiDocumentHandle& tixiHandle, const std::string& xpath, const std::string& attribute)
+    {
+        return TixiGetTimeTAttribute(tixiHandle, xpath, attribute);
+    }
+
+    inline void TixiSaveAttribute(const TixiDocumentHandle& tixiHandle, const std::string& xpath, const std::string& attribute, std::time_t value)
+    {
+        TixiSaveAttribute(tixiHandle, xpath, attribute, boost::posix_time::to_iso_extended_string(boost::posix_time::from_time_t(value)));
+    }
+
+    // variants of the functions modifying the document, which drop its element index first. Used by the generated WriteCPACS.
+    // The plain tixicpp functions and their overloads above never touch the index, call TixiInvalidateElementIndex after them while an index is enabled
+    inline void TixiCreateElementIndexed(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
+    {
+        TixiInvalidateElementIndex(tixiHandle);
+        TixiCreateElement(tixiHandle, xpath);
+    }
+
+    // index starts at 1
+    inline void TixiCreateElementAtIndexIndexed(const TixiDocumentHandle& tixiHandle, const std::string& parentXPath, const std::string& element, int index)
+    {
+        TixiInvalidateElementIndex(tixiHandle);
+        tixiCreateElementAtIndex(tixiHandle, parentXPath.c_str(), element.c_str(), index);
+    }
+
+    inline void TixiCreateElementIfNotExistsIndexed(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
+    {
+        TixiInvalidateElementIndex(tixiHandle);
+        TixiCreateElementIfNotExists(tixiHandle, xpath);
+    }
+
+    inline void TixiRemoveElementIndexed(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
+    {
+        TixiInvalidateElementIndex(tixiHandle);
+        TixiRemoveElement(tixiHandle, xpath);
+    }
+
+    template<typename T>
+    void TixiSaveElementIndexed(const TixiDocumentHandle& tixiHandle, const std::string& xpath, const T& value)
+    {
+        TixiInvalidateElementIndex(tixiHandle);
+        TixiSaveElement(tixiHandle, xpath, value);
+    }
+
+    template<typename T>
+    void TixiSaveAttributeIndexed(const TixiDocumentHandle& tixiHandle, const std::string& xpath, const std::string& attribute, const T& value)
+    {
+        TixiInvalidateElementIndex(tixiHandle);
+        TixiSaveAttribute(tixiHandle, xpath, attribute, value);
+    }
+
+    inline void TixiRemoveAttributeIndexed(const TixiDocumentHandle& tixiHandle, const std::string& xpath, const std::string& attribute)
+    {
+        TixiInvalidateElementIndex(tixiHandle);
+        TixiRemoveAttribute(tixiHandle, xpath, attribute);
+    }
+
+    // closes the document and drops its element index, which would otherwise be used by a later document with the same handle
+    inline void TixiCloseDocumentIndexed(const TixiDocumentHandle& tixiHandle)
+    {
+        TixiDisableElementIndex(tixiHandle);
+        tixiCloseDocument(tixiHandle);
+    }
+
+    namespace internal
+    {
+        // reads a value through the C API, which reports a missing element or attribute by its return code
+        template<typename T>
+        struct TixiValueReader;
+
+        template<>
+        struct TixiValueReader<std::string>
+        {
+            static ReturnCode element(const TixiDocumentHandle& tixiHandle, const std::string& xpath, std::string& value)
+            {
+                char* text = nullptr;
+                const ReturnCode ret = tixiGetTextElement(tixiHandle, xpath.c_str(), &text);
+                if (ret == SUCCESS) {
+                    value = text;
+                }
+                return ret;
+            }
+
+            static ReturnCode attribute(const TixiDocumentHandle& tixiHandle, const std::string& xpath, const std::string& attribute, std::string& value)
+            {
+                char* text = nullptr;
+                const ReturnCode ret = tixiGetTextAttribute(tixiHandle, xpath.c_str(), attribute.c_str(), &text);
+                if (ret == SUCCESS) {
+                    value = text;
+                }
+                return ret;
+            }
+        };
+
+        template<>
+        struct TixiValueReader<double>
+        {
+            static ReturnCode element(const TixiDocumentHandle& tixiHandle, const std::string& xpath, double& value)
+            {
+                return tixiGetDoubleElement(tixiHandle, xpath.c_str(), &value);
+            }
+
+            static ReturnCode attribute(const TixiDocumentHandle& tixiHandle, const std::string& xpath, const std::string& attribute, double& value)
+            {
+                return tixiGetDoubleAttribute(tixiHandle, xpath.c_str(), attribute.c_str(), &value);
+            }
+        };
+
+        template<>
+        struct TixiValueReader<int>
+        {
+            static ReturnCode element(const TixiDocumentHandle& tixiHandle, const std::string& xpath, int& value)
+            {
+                return tixiGetIntegerElement(tixiHandle, xpath.c_str(), &value);
+            }
+
+            static ReturnCode attribute(const TixiDocumentHandle& tixiHandle, const std::string& xpath, const std::string& attribute, int& value)
+            {
+                return tixiGetIntegerAttribute(tixiHandle, xpath.c_str(), attribute.c_str(), &value);
+            }
+        };
+
+        template<>
+        struct TixiValueReader<bool>
+        {
+            static ReturnCode element(const TixiDocumentHandle& tixiHandle, const std::string& xpath, bool& value)
+            {
+                int b = 0;
+                const ReturnCode ret = tixiGetBooleanElement(tixiHandle, xpath.c_str(), &b);
+                value = b != 0;
+                return ret;
+            }
+
+            static ReturnCode attribute(const TixiDocumentHandle& tixiHandle, const std::string& xpath, const std::string& attribute, bool& value)
+            {
+                int b = 0;
+                const ReturnCode ret = tixiGetBooleanAttribute(tixiHandle, xpath.c_str(), attribute.c_str(), &b);
+                value = b != 0;
+                return ret;
+            }
+        };
+
+        template<>
+        struct TixiValueReader<std::time_t>
+        {
+            static ReturnCode element(const TixiDocumentHandle& tixiHandle, const std::string& xpath, std::time_t& value)
+            {
+                std::string text;
+                const ReturnCode ret = TixiValueReader<std::string>::element(tixiHandle, xpath, text);
+                if (ret == SUCCESS) {
+                    value = boost::posix_time::to_time_t(boost::posix_time::from_iso_extended_string(text));
+                }
+                return ret;
+            }
+
+            static ReturnCode attribute(const TixiDocumentHandle& tixiHandle, const std::string& xpath, const std::string& attribute, std::time_t& value)
+            {
+                std::string text;
+                const ReturnCode ret = TixiValueReader<std::string>::attribute(tixiHandle, xpath, attribute, text);
+                if (ret == SUCCESS) {
+                    value = boost::posix_time::to_time_t(boost::posix_time::from_iso_extended_string(text));
+                }
+                return ret;
+            }
+        };
+    }
+
+    // reads the element at xpath with a single lookup, returns boost::none if it does not exist.
+    // Replaces checking for the element with TixiCheckElement before reading it, which evaluates xpath twice
+    template<typename T>
+    boost::optional<T> TixiTryGetElement(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
+    {
+        if (const auto index = TixiGetElementIndex(tixiHandle)) {
+            if (index->checkElement(xpath) == false) {
+                return boost::none;
+            }
+        }
+        T value;
+        const ReturnCode ret = internal::TixiValueReader<T>::element(tixiHandle, xpath, value);
+        if (ret == SUCCESS) {
+            return value;
+        }
+        if (ret == ELEMENT_NOT_FOUND) {
+            return boost::none;
+        }
+        // let the regular read report the error
+        return TixiGetElement<T>(tixiHandle, xpath);
+    }
+
+    // reads the attribute of the element at xpath with a single lookup, returns boost::none if it does not exist
+    template<typename T>
+    boost::optional<T> TixiTryGetAttribute(const TixiDocumentHandle& tixiHandle, const std::string& xpath, const std::string& attribute)
+    {
+        if (const auto index = TixiGetElementIndex(tixiHandle)) {
+            if (index->checkAttribute(xpath, attribute) == false) {
+                return boost::none;
+            }
+        }
+        T value;
+        const ReturnCode ret = internal::TixiValueReader<T>::attribute(tixiHandle, xpath, attribute, value);
+        if (ret == SUCCESS) {
+            return value;
+        }
+        if (ret == ATTRIBUTE_NOT_FOUND || ret == ELEMENT_NOT_FOUND) {
+            return boost::none;
+        }
+        return TixiGetAttribute<T>(tixiHandle, xpath, attribute);
+    }
+
     constexpr auto xsdUnbounded = std::numeric_limits<unsigned int>::max();
 
     template<typename T, typename ReadChildFunc, typename... ChildCtorArgs>
     void TixiReadElementsInternal(const TixiDocumentHandle& tixiHandle, const std::string& xpath, std::vector<T>& children, unsigned int minOccurs, unsigned int maxOccurs, ReadChildFunc readChild, ChildCtorArgs&&... args)
     {
         // read number of child nodes
-        const auto childCount = static_cast<unsigned int>(TixiGetNamedChildrenCount(tixiHandle, xpath));
+        const auto childCount = static_cast<unsigned int>(TixiGetNamedChildrenCountIndexed(tixiHandle, xpath));
 
         // validate number of child nodes
         if (childCount < minOccurs) {
@@ -140,7 +743,7 @@ namespace tixi
                 // if child node does not exist, create it
                 const std::string& childPath = xpath + "[" + std::to_string(i + 1) + "]";
                 if (!TixiCheckElement(tixiHandle, childPath)) {
-                    TixiCreateElement(tixiHandle, xpath);
+                    TixiCreateElementIndexed(tixiHandle, xpath);
                 }
 
                 // write child node
@@ -150,7 +753,7 @@ namespace tixi
             
         // delete old children which where not overwritten
         for (std::size_t i = children.size() + 1; i <= static_cast<std::size_t>(childCount); i++) {
-            TixiRemoveElement(tixiHandle, xpath + "[" + std::to_string(children.size() + 1) + "]");
+            TixiRemoveElementIndexed(tixiHandle, xpath + "[" + std::to_string(children.size() + 1) + "]");
         }
     }
 
@@ -158,7 +761,7 @@ namespace tixi
     void TixiSaveElements(const TixiDocumentHandle& tixiHandle, const std::string& xpath, const std::vector<T>& children)
     {
         auto writer = [&](const std::string& childXPath, const T& child) {
-            TixiSaveElement(tixiHandle, childXPath, child);
+            TixiSaveElementIndexed(tixiHandle, childXPath, child);
         };
         TixiSaveElementsInternal(tixiHandle, xpath, children, writer);
     }
@@ -187,14 +790,14 @@ namespace tixi
             while (++it != childElemOrder.end()) {
                 for (int i = 1; i <= numChildren; i++) {
                     if (TixiGetChildNodeName(tixiHandle, sp.parentXPath, i) == *it) {
-                        tixiCreateElementAtIndex(tixiHandle, sp.parentXPath.c_str(), sp.element.c_str(), i);
+                        TixiCreateElementAtIndexIndexed(tixiHandle, sp.parentXPath, sp.element, i);
                         return;
                     }
                 }
             }
         }
         // in case no place for insertion was found append the new element
-        TixiCreateElement(tixiHandle, xpath);
+        TixiCreateElementIndexed(tixiHandle, xpath);
     }
 
 }
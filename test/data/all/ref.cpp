@@ -132,42 +132,42 @@ namespace generated
     void CPACSRoot::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         // read element a
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/a")) {
-            m_a = tixi::TixiGetElement<int>(tixiHandle, xpath + "/a");
+        if (const boost::optional<int> value = tixi::TixiTryGetElement<int>(tixiHandle, xpath + "/a")) {
+            m_a = *value;
         }
         else {
             LOG(ERROR) << "Required element a is missing at xpath " << xpath;
         }
 
         // read element b
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/b")) {
-            m_b = tixi::TixiGetElement<int>(tixiHandle, xpath + "/b");
+        if (const boost::optional<int> value = tixi::TixiTryGetElement<int>(tixiHandle, xpath + "/b")) {
+            m_b = *value;
         }
 
         // read element c
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/c")) {
-            m_c = tixi::TixiGetElement<int>(tixiHandle, xpath + "/c");
+        if (const boost::optional<int> value = tixi::TixiTryGetElement<int>(tixiHandle, xpath + "/c")) {
+            m_c = *value;
         }
         else {
             LOG(ERROR) << "Required element c is missing at xpath " << xpath;
         }
 
         // read element d
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/d")) {
-            m_d = tixi::TixiGetElement<int>(tixiHandle, xpath + "/d");
+        if (const boost::optional<int> value = tixi::TixiTryGetElement<int>(tixiHandle, xpath + "/d")) {
+            m_d = *value;
         }
         else {
             LOG(ERROR) << "Required element d is missing at xpath " << xpath;
         }
 
         // read element e
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/e")) {
-            m_e = tixi::TixiGetElement<int>(tixiHandle, xpath + "/e");
+        if (const boost::optional<int> value = tixi::TixiTryGetElement<int>(tixiHandle, xpath + "/e")) {
+            m_e = *value;
         }
 
         // read element f
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/f")) {
-            m_f = tixi::TixiGetElement<int>(tixiHandle, xpath + "/f");
+        if (const boost::optional<int> value = tixi::TixiTryGetElement<int>(tixiHandle, xpath + "/f")) {
+            m_f = *value;
         }
         else {
             LOG(ERROR) << "Required element f is missing at xpath " << xpath;
@@ -178,42 +178,42 @@ namespace generated
     void CPACSRoot::WriteCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath) const
     {
         // write element a
-        tixi::TixiCreateElementIfNotExists(tixiHandle, xpath + "/a");
-        tixi::TixiSaveElement(tixiHandle, xpath + "/a", m_a);
+        tixi::TixiCreateElementIfNotExistsIndexed(tixiHandle, xpath + "/a");
+        tixi::TixiSaveElementIndexed(tixiHandle, xpath + "/a", m_a);
 
         // write element b
         if (m_b) {
-            tixi::TixiCreateElementIfNotExists(tixiHandle, xpath + "/b");
-            tixi::TixiSaveElement(tixiHandle, xpath + "/b", *m_b);
+            tixi::TixiCreateElementIfNotExistsIndexed(tixiHandle, xpath + "/b");
+            tixi::TixiSaveElementIndexed(tixiHandle, xpath + "/b", *m_b);
         }
         else {
             if (tixi::TixiCheckElement(tixiHandle, xpath + "/b")) {
-                tixi::TixiRemoveElement(tixiHandle, xpath + "/b");
+                tixi::TixiRemoveElementIndexed(tixiHandle, xpath + "/b");
             }
         }
 
         // write element c
-        tixi::TixiCreateElementIfNotExists(tixiHandle, xpath + "/c");
-        tixi::TixiSaveElement(tixiHandle, xpath + "/c", m_c);
+        tixi::TixiCreateElementIfNotExistsIndexed(tixiHandle, xpath + "/c");
+        tixi::TixiSaveElementIndexed(tixiHandle, xpath + "/c", m_c);
 
         // write element d
-        tixi::TixiCreateElementIfNotExists(tixiHandle, xpath + "/d");
-        tixi::TixiSaveElement(tixiHandle, xpath + "/d", m_d);
+        tixi::TixiCreateElementIfNotExistsIndexed(tixiHandle, xpath + "/d");
+        tixi::TixiSaveElementIndexed(tixiHandle, xpath + "/d", m_d);
 
         // write element e
         if (m_e) {
-            tixi::TixiCreateElementIfNotExists(tixiHandle, xpath + "/e");
-            tixi::TixiSaveElement(tixiHandle, xpath + "/e", *m_e);
+            tixi::TixiCreateElementIfNotExistsIndexed(tixiHandle, xpath + "/e");
+            tixi::TixiSaveElementIndexed(tixiHandle, xpath + "/e", *m_e);
         }
         else {
             if (tixi::TixiCheckElement(tixiHandle, xpath + "/e")) {
-                tixi::TixiRemoveElement(tixiHandle, xpath + "/e");
+                tixi::TixiRemoveElementIndexed(tixiHandle, xpath + "/e");
             }
         }
 
         // write element f
-        tixi::TixiCreateElementIfNotExists(tixiHandle, xpath + "/f");
-        tixi::TixiSaveElement(tixiHandle, xpath + "/f", m_f);
+        tixi::TixiCreateElementIfNotExistsIndexed(tixiHandle, xpath + "/f");
+        tixi::TixiSaveElementIndexed(tixiHandle, xpath + "/f", m_f);
 
     }
 
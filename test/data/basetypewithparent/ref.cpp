@@ -476,8 +476,8 @@ namespace generated
     void CPACSBase::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         // read attribute uID
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "uID")) {
-            m_uID = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "uID");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "uID")) {
+            m_uID = *value;
             if (m_uID.empty()) {
                 LOG(WARNING) << "Required attribute uID is empty at xpath " << xpath;
             }
@@ -492,7 +492,7 @@ namespace generated
     void CPACSBase::WriteCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath) const
     {
         // write attribute uID
-        tixi::TixiSaveAttribute(tixiHandle, xpath, "uID", m_uID);
+        tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "uID", m_uID);
 
     }
 
@@ -602,8 +602,8 @@ namespace generated
     void CPACSDerived::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         // read attribute uID
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "uID")) {
-            m_uID = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "uID");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "uID")) {
+            m_uID = *value;
             if (m_uID.empty()) {
                 LOG(WARNING) << "Required attribute uID is empty at xpath " << xpath;
             }
@@ -613,8 +613,8 @@ namespace generated
         }
 
         // read element name
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/name")) {
-            m_name = tixi::TixiGetElement<std::string>(tixiHandle, xpath + "/name");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetElement<std::string>(tixiHandle, xpath + "/name")) {
+            m_name = *value;
             if (m_name->empty()) {
                 LOG(WARNING) << "Optional element name is present but empty at xpath " << xpath;
             }
@@ -626,16 +626,16 @@ namespace generated
     void CPACSDerived::WriteCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath) const
     {
         // write attribute uID
-        tixi::TixiSaveAttribute(tixiHandle, xpath, "uID", m_uID);
+        tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "uID", m_uID);
 
         // write element name
         if (m_name) {
-            tixi::TixiCreateElementIfNotExists(tixiHandle, xpath + "/name");
-            tixi::TixiSaveElement(tixiHandle, xpath + "/name", *m_name);
+            tixi::TixiCreateElementIfNotExistsIndexed(tixiHandle, xpath + "/name");
+            tixi::TixiSaveElementIndexed(tixiHandle, xpath + "/name", *m_name);
         }
         else {
             if (tixi::TixiCheckElement(tixiHandle, xpath + "/name")) {
-                tixi::TixiRemoveElement(tixiHandle, xpath + "/name");
+                tixi::TixiRemoveElementIndexed(tixiHandle, xpath + "/name");
             }
         }
 
@@ -739,7 +739,7 @@ namespace generated
     void CPACSRoot::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         // read element a
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/a")) {
+        if (tixi::TixiCheckElementIndexed(tixiHandle, xpath + "/a")) {
             m_a.ReadCPACS(tixiHandle, xpath + "/a");
         }
         else {
@@ -747,7 +747,7 @@ namespace generated
         }
 
         // read element b
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/b")) {
+        if (tixi::TixiCheckElementIndexed(tixiHandle, xpath + "/b")) {
             m_b.ReadCPACS(tixiHandle, xpath + "/b");
         }
         else {
@@ -879,7 +879,7 @@ namespace generated
     void CPACSTypeA::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         // read element data
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/data")) {
+        if (tixi::TixiCheckElementIndexed(tixiHandle, xpath + "/data")) {
             m_data.ReadCPACS(tixiHandle, xpath + "/data");
         }
         else {
@@ -891,7 +891,7 @@ namespace generated
     void CPACSTypeA::WriteCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath) const
     {
         // write element data
-        tixi::TixiCreateElementIfNotExists(tixiHandle, xpath + "/data");
+        tixi::TixiCreateElementIfNotExistsIndexed(tixiHandle, xpath + "/data");
         m_data.WriteCPACS(tixiHandle, xpath + "/data");
 
     }
@@ -995,7 +995,7 @@ namespace generated
     void CPACSTypeB::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         // read element data
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/data")) {
+        if (tixi::TixiCheckElementIndexed(tixiHandle, xpath + "/data")) {
             m_data.ReadCPACS(tixiHandle, xpath + "/data");
         }
         else {
@@ -1007,7 +1007,7 @@ namespace generated
     void CPACSTypeB::WriteCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath) const
     {
         // write element data
-        tixi::TixiCreateElementIfNotExists(tixiHandle, xpath + "/data");
+        tixi::TixiCreateElementIfNotExistsIndexed(tixiHandle, xpath + "/data");
         m_data.WriteCPACS(tixiHandle, xpath + "/data");
 
     }
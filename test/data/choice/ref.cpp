@@ -114,13 +114,13 @@ namespace generated
     void CPACSRoot::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         // read element a
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/a")) {
-            m_a_choice1 = tixi::TixiGetElement<int>(tixiHandle, xpath + "/a");
+        if (const boost::optional<int> value = tixi::TixiTryGetElement<int>(tixiHandle, xpath + "/a")) {
+            m_a_choice1 = *value;
         }
 
         // read element b
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/b")) {
-            m_b_choice2 = tixi::TixiGetElement<int>(tixiHandle, xpath + "/b");
+        if (const boost::optional<int> value = tixi::TixiTryGetElement<int>(tixiHandle, xpath + "/b")) {
+            m_b_choice2 = *value;
         }
 
         if (!ValidateChoices()) {
@@ -132,23 +132,23 @@ namespace generated
     {
         // write element a
         if (m_a_choice1) {
-            tixi::TixiCreateElementIfNotExists(tixiHandle, xpath + "/a");
-            tixi::TixiSaveElement(tixiHandle, xpath + "/a", *m_a_choice1);
+            tixi::TixiCreateElementIfNotExistsIndexed(tixiHandle, xpath + "/a");
+            tixi::TixiSaveElementIndexed(tixiHandle, xpath + "/a", *m_a_choice1);
         }
         else {
             if (tixi::TixiCheckElement(tixiHandle, xpath + "/a")) {
-                tixi::TixiRemoveElement(tixiHandle, xpath + "/a");
+                tixi::TixiRemoveElementIndexed(tixiHandle, xpath + "/a");
             }
         }
 
         // write element b
         if (m_b_choice2) {
-            tixi::TixiCreateElementIfNotExists(tixiHandle, xpath + "/b");
-            tixi::TixiSaveElement(tixiHandle, xpath + "/b", *m_b_choice2);
+            tixi::TixiCreateElementIfNotExistsIndexed(tixiHandle, xpath + "/b");
+            tixi::TixiSaveElementIndexed(tixiHandle, xpath + "/b", *m_b_choice2);
         }
         else {
             if (tixi::TixiCheckElement(tixiHandle, xpath + "/b")) {
-                tixi::TixiRemoveElement(tixiHandle, xpath + "/b");
+                tixi::TixiRemoveElementIndexed(tixiHandle, xpath + "/b");
             }
         }
 
@@ -566,7 +566,7 @@ namespace generated
     void CPACSRoot::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         // read element a
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/a")) {
+        if (tixi::TixiCheckElementIndexed(tixiHandle, xpath + "/a")) {
             m_a.ReadCPACS(tixiHandle, xpath + "/a");
         }
         else {
@@ -574,7 +574,7 @@ namespace generated
         }
 
         // read element b
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/b")) {
+        if (tixi::TixiCheckElementIndexed(tixiHandle, xpath + "/b")) {
             m_b.ReadCPACS(tixiHandle, xpath + "/b");
         }
         else {
@@ -582,7 +582,7 @@ namespace generated
         }
 
         // read element c
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/c")) {
+        if (tixi::TixiCheckElementIndexed(tixiHandle, xpath + "/c")) {
             m_c.ReadCPACS(tixiHandle, xpath + "/c");
         }
         else {
@@ -590,7 +590,7 @@ namespace generated
         }
 
         // read element d
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/d")) {
+        if (tixi::TixiCheckElementIndexed(tixiHandle, xpath + "/d")) {
             m_d.ReadCPACS(tixiHandle, xpath + "/d");
         }
         else {
@@ -731,16 +731,16 @@ namespace generated
     void CPACSTypeA::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         // read attribute id
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "id")) {
-            m_id = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "id");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "id")) {
+            m_id = *value;
             if (m_id->empty()) {
                 LOG(WARNING) << "Optional attribute id is present but empty at xpath " << xpath;
             }
         }
 
         // read attribute color
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "color")) {
-            m_color = stringToCPACSColor(tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "color"));
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "color")) {
+            m_color = stringToCPACSColor(*value);
         }
 
     }
@@ -749,21 +749,21 @@ namespace generated
     {
         // write attribute id
         if (m_id) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "id", *m_id);
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "id", *m_id);
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "id")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "id");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "id");
             }
         }
 
         // write attribute color
         if (m_color) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "color", CPACSColorToString(*m_color));
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "color", CPACSColorToString(*m_color));
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "color")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "color");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "color");
             }
         }
 
@@ -859,16 +859,16 @@ namespace generated
     void CPACSTypeB::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         // read attribute id
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "id")) {
-            m_id = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "id");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "id")) {
+            m_id = *value;
             if (m_id->empty()) {
                 LOG(WARNING) << "Optional attribute id is present but empty at xpath " << xpath;
             }
         }
 
         // read attribute color
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "color")) {
-            m_color = stringToCPACSColor(tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "color"));
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "color")) {
+            m_color = stringToCPACSColor(*value);
         }
 
     }
@@ -877,21 +877,21 @@ namespace generated
     {
         // write attribute id
         if (m_id) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "id", *m_id);
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "id", *m_id);
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "id")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "id");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "id");
             }
         }
 
         // write attribute color
         if (m_color) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "color", CPACSColorToString(*m_color));
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "color", CPACSColorToString(*m_color));
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "color")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "color");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "color");
             }
         }
 
@@ -987,16 +987,16 @@ namespace generated
     void CPACSTypeC::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         // read attribute id
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "id")) {
-            m_id = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "id");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "id")) {
+            m_id = *value;
             if (m_id->empty()) {
                 LOG(WARNING) << "Optional attribute id is present but empty at xpath " << xpath;
             }
         }
 
         // read attribute color
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "color")) {
-            m_color = stringToCPACSTypeC_color(tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "color"));
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "color")) {
+            m_color = stringToCPACSTypeC_color(*value);
         }
 
     }
@@ -1005,21 +1005,21 @@ namespace generated
     {
         // write attribute id
         if (m_id) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "id", *m_id);
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "id", *m_id);
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "id")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "id");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "id");
             }
         }
 
         // write attribute color
         if (m_color) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "color", CPACSTypeC_colorToString(*m_color));
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "color", CPACSTypeC_colorToString(*m_color));
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "color")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "color");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "color");
             }
         }
 
@@ -1115,16 +1115,16 @@ namespace generated
     void CPACSTypeD::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         // read attribute id
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "id")) {
-            m_id = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "id");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "id")) {
+            m_id = *value;
             if (m_id->empty()) {
                 LOG(WARNING) << "Optional attribute id is present but empty at xpath " << xpath;
             }
         }
 
         // read attribute color
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "color")) {
-            m_color = stringToCPACSTypeC_color(tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "color"));
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "color")) {
+            m_color = stringToCPACSTypeC_color(*value);
         }
 
     }
@@ -1133,21 +1133,21 @@ namespace generated
     {
         // write attribute id
         if (m_id) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "id", *m_id);
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "id", *m_id);
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "id")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "id");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "id");
             }
         }
 
         // write attribute color
         if (m_color) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "color", CPACSTypeC_colorToString(*m_color));
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "color", CPACSTypeC_colorToString(*m_color));
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "color")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "color");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "color");
             }
         }
 
@@ -353,72 +353,72 @@ namespace generated
     void CPACSDoubleVectorBase::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         // read attribute mapType
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "mapType")) {
-            m_mapType = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "mapType");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "mapType")) {
+            m_mapType = *value;
             if (m_mapType->empty()) {
                 LOG(WARNING) << "Optional attribute mapType is present but empty at xpath " << xpath;
             }
         }
 
         // read attribute mu
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "mu")) {
-            m_mu = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "mu");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "mu")) {
+            m_mu = *value;
             if (m_mu->empty()) {
                 LOG(WARNING) << "Optional attribute mu is present but empty at xpath " << xpath;
             }
         }
 
         // read attribute delta
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "delta")) {
-            m_delta = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "delta");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "delta")) {
+            m_delta = *value;
             if (m_delta->empty()) {
                 LOG(WARNING) << "Optional attribute delta is present but empty at xpath " << xpath;
             }
         }
 
         // read attribute a
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "a")) {
-            m_a = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "a");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "a")) {
+            m_a = *value;
             if (m_a->empty()) {
                 LOG(WARNING) << "Optional attribute a is present but empty at xpath " << xpath;
             }
         }
 
         // read attribute b
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "b")) {
-            m_b = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "b");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "b")) {
+            m_b = *value;
             if (m_b->empty()) {
                 LOG(WARNING) << "Optional attribute b is present but empty at xpath " << xpath;
             }
         }
 
         // read attribute c
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "c")) {
-            m_c = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "c");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "c")) {
+            m_c = *value;
             if (m_c->empty()) {
                 LOG(WARNING) << "Optional attribute c is present but empty at xpath " << xpath;
             }
         }
 
         // read attribute v
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "v")) {
-            m_v = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "v");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "v")) {
+            m_v = *value;
             if (m_v->empty()) {
                 LOG(WARNING) << "Optional attribute v is present but empty at xpath " << xpath;
             }
         }
 
         // read attribute w
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "w")) {
-            m_w = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "w");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "w")) {
+            m_w = *value;
             if (m_w->empty()) {
                 LOG(WARNING) << "Optional attribute w is present but empty at xpath " << xpath;
             }
         }
 
         // read simpleContent 
-        if (tixi::TixiCheckElement(tixiHandle, xpath)) {
-            m_value = tixi::TixiGetElement<std::string>(tixiHandle, xpath);
+        if (const boost::optional<std::string> value = tixi::TixiTryGetElement<std::string>(tixiHandle, xpath)) {
+            m_value = *value;
             if (m_value.empty()) {
                 LOG(WARNING) << "Required element  is empty at xpath " << xpath;
             }
@@ -433,86 +433,86 @@ namespace generated
     {
         // write attribute mapType
         if (m_mapType) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "mapType", *m_mapType);
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "mapType", *m_mapType);
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "mapType")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "mapType");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "mapType");
             }
         }
 
         // write attribute mu
         if (m_mu) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "mu", *m_mu);
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "mu", *m_mu);
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "mu")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "mu");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "mu");
             }
         }
 
         // write attribute delta
         if (m_delta) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "delta", *m_delta);
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "delta", *m_delta);
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "delta")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "delta");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "delta");
             }
         }
 
         // write attribute a
         if (m_a) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "a", *m_a);
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "a", *m_a);
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "a")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "a");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "a");
             }
         }
 
         // write attribute b
         if (m_b) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "b", *m_b);
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "b", *m_b);
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "b")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "b");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "b");
             }
         }
 
         // write attribute c
         if (m_c) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "c", *m_c);
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "c", *m_c);
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "c")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "c");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "c");
             }
         }
 
         // write attribute v
         if (m_v) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "v", *m_v);
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "v", *m_v);
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "v")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "v");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "v");
             }
         }
 
         // write attribute w
         if (m_w) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "w", *m_w);
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "w", *m_w);
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "w")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "w");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "w");
             }
         }
 
         // write simpleContent 
-        tixi::TixiSaveElement(tixiHandle, xpath, m_value);
+        tixi::TixiSaveElementIndexed(tixiHandle, xpath, m_value);
 
     }
 
@@ -656,7 +656,7 @@ namespace generated
     void CPACSRoot::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         // read element stringVector
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/stringVector")) {
+        if (tixi::TixiCheckElementIndexed(tixiHandle, xpath + "/stringVector")) {
             m_stringVector = boost::in_place(this);
             try {
                 m_stringVector->ReadCPACS(tixiHandle, xpath + "/stringVector");
@@ -667,7 +667,7 @@ namespace generated
         }
 
         // read element doubleVector
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/doubleVector")) {
+        if (tixi::TixiCheckElementIndexed(tixiHandle, xpath + "/doubleVector")) {
             m_doubleVector = boost::in_place(this);
             try {
                 m_doubleVector->ReadCPACS(tixiHandle, xpath + "/doubleVector");
@@ -690,7 +690,7 @@ namespace generated
         }
         else {
             if (tixi::TixiCheckElement(tixiHandle, xpath + "/stringVector")) {
-                tixi::TixiRemoveElement(tixiHandle, xpath + "/stringVector");
+                tixi::TixiRemoveElementIndexed(tixiHandle, xpath + "/stringVector");
             }
         }
 
@@ -701,7 +701,7 @@ namespace generated
         }
         else {
             if (tixi::TixiCheckElement(tixiHandle, xpath + "/doubleVector")) {
-                tixi::TixiRemoveElement(tixiHandle, xpath + "/doubleVector");
+                tixi::TixiRemoveElementIndexed(tixiHandle, xpath + "/doubleVector");
             }
         }
 
@@ -821,72 +821,72 @@ namespace generated
     void CPACSStringVectorBase::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         // read attribute mapType
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "mapType")) {
-            m_mapType = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "mapType");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "mapType")) {
+            m_mapType = *value;
             if (m_mapType->empty()) {
                 LOG(WARNING) << "Optional attribute mapType is present but empty at xpath " << xpath;
             }
         }
 
         // read attribute mu
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "mu")) {
-            m_mu = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "mu");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "mu")) {
+            m_mu = *value;
             if (m_mu->empty()) {
                 LOG(WARNING) << "Optional attribute mu is present but empty at xpath " << xpath;
             }
         }
 
         // read attribute delta
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "delta")) {
-            m_delta = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "delta");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "delta")) {
+            m_delta = *value;
             if (m_delta->empty()) {
                 LOG(WARNING) << "Optional attribute delta is present but empty at xpath " << xpath;
             }
         }
 
         // read attribute a
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "a")) {
-            m_a = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "a");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "a")) {
+            m_a = *value;
             if (m_a->empty()) {
                 LOG(WARNING) << "Optional attribute a is present but empty at xpath " << xpath;
             }
         }
 
         // read attribute b
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "b")) {
-            m_b = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "b");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "b")) {
+            m_b = *value;
             if (m_b->empty()) {
                 LOG(WARNING) << "Optional attribute b is present but empty at xpath " << xpath;
             }
         }
 
         // read attribute c
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "c")) {
-            m_c = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "c");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "c")) {
+            m_c = *value;
             if (m_c->empty()) {
                 LOG(WARNING) << "Optional attribute c is present but empty at xpath " << xpath;
             }
         }
 
         // read attribute v
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "v")) {
-            m_v = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "v");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "v")) {
+            m_v = *value;
             if (m_v->empty()) {
                 LOG(WARNING) << "Optional attribute v is present but empty at xpath " << xpath;
             }
         }
 
         // read attribute w
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "w")) {
-            m_w = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "w");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "w")) {
+            m_w = *value;
             if (m_w->empty()) {
                 LOG(WARNING) << "Optional attribute w is present but empty at xpath " << xpath;
             }
         }
 
         // read simpleContent 
-        if (tixi::TixiCheckElement(tixiHandle, xpath)) {
-            m_value = tixi::TixiGetElement<std::string>(tixiHandle, xpath);
+        if (const boost::optional<std::string> value = tixi::TixiTryGetElement<std::string>(tixiHandle, xpath)) {
+            m_value = *value;
             if (m_value.empty()) {
                 LOG(WARNING) << "Required element  is empty at xpath " << xpath;
             }
@@ -901,86 +901,86 @@ namespace generated
     {
         // write attribute mapType
         if (m_mapType) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "mapType", *m_mapType);
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "mapType", *m_mapType);
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "mapType")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "mapType");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "mapType");
             }
         }
 
         // write attribute mu
         if (m_mu) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "mu", *m_mu);
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "mu", *m_mu);
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "mu")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "mu");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "mu");
             }
         }
 
         // write attribute delta
         if (m_delta) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "delta", *m_delta);
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "delta", *m_delta);
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "delta")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "delta");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "delta");
             }
         }
 
         // write attribute a
         if (m_a) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "a", *m_a);
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "a", *m_a);
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "a")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "a");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "a");
             }
         }
 
         // write attribute b
         if (m_b) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "b", *m_b);
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "b", *m_b);
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "b")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "b");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "b");
             }
         }
 
         // write attribute c
         if (m_c) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "c", *m_c);
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "c", *m_c);
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "c")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "c");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "c");
             }
         }
 
         // write attribute v
         if (m_v) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "v", *m_v);
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "v", *m_v);
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "v")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "v");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "v");
             }
         }
 
         // write attribute w
         if (m_w) {
-            tixi::TixiSaveAttribute(tixiHandle, xpath, "w", *m_w);
+            tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "w", *m_w);
         }
         else {
             if (tixi::TixiCheckAttribute(tixiHandle, xpath, "w")) {
-                tixi::TixiRemoveAttribute(tixiHandle, xpath, "w");
+                tixi::TixiRemoveAttributeIndexed(tixiHandle, xpath, "w");
             }
         }
 
         // write simpleContent 
-        tixi::TixiSaveElement(tixiHandle, xpath, m_value);
+        tixi::TixiSaveElementIndexed(tixiHandle, xpath, m_value);
 
     }
 
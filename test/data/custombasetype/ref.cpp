@@ -236,8 +236,8 @@ namespace generated
     void CPACSDerived::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         // read attribute uID
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "uID")) {
-            m_uID = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "uID");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "uID")) {
+            m_uID = *value;
             if (m_uID.empty()) {
                 LOG(WARNING) << "Required attribute uID is empty at xpath " << xpath;
             }
@@ -247,8 +247,8 @@ namespace generated
         }
 
         // read element name
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/name")) {
-            m_name = tixi::TixiGetElement<std::string>(tixiHandle, xpath + "/name");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetElement<std::string>(tixiHandle, xpath + "/name")) {
+            m_name = *value;
             if (m_name->empty()) {
                 LOG(WARNING) << "Optional element name is present but empty at xpath " << xpath;
             }
@@ -260,16 +260,16 @@ namespace generated
     void CPACSDerived::WriteCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath) const
     {
         // write attribute uID
-        tixi::TixiSaveAttribute(tixiHandle, xpath, "uID", m_uID);
+        tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "uID", m_uID);
 
         // write element name
         if (m_name) {
-            tixi::TixiCreateElementIfNotExists(tixiHandle, xpath + "/name");
-            tixi::TixiSaveElement(tixiHandle, xpath + "/name", *m_name);
+            tixi::TixiCreateElementIfNotExistsIndexed(tixiHandle, xpath + "/name");
+            tixi::TixiSaveElementIndexed(tixiHandle, xpath + "/name", *m_name);
         }
         else {
             if (tixi::TixiCheckElement(tixiHandle, xpath + "/name")) {
-                tixi::TixiRemoveElement(tixiHandle, xpath + "/name");
+                tixi::TixiRemoveElementIndexed(tixiHandle, xpath + "/name");
             }
         }
 
@@ -372,7 +372,7 @@ namespace generated
     void CPACSRoot::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         // read element a
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/a")) {
+        if (tixi::TixiCheckElementIndexed(tixiHandle, xpath + "/a")) {
             m_a.ReadCPACS(tixiHandle, xpath + "/a");
         }
         else {
@@ -384,7 +384,7 @@ namespace generated
     void CPACSRoot::WriteCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath) const
     {
         // write element a
-        tixi::TixiCreateElementIfNotExists(tixiHandle, xpath + "/a");
+        tixi::TixiCreateElementIfNotExistsIndexed(tixiHandle, xpath + "/a");
         m_a.WriteCPACS(tixiHandle, xpath + "/a");
 
     }
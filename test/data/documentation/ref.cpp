@@ -128,24 +128,24 @@ namespace generated
     void CPACSRoot::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         // read attribute c
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "c")) {
-            m_c = tixi::TixiGetAttribute<int>(tixiHandle, xpath, "c");
+        if (const boost::optional<int> value = tixi::TixiTryGetAttribute<int>(tixiHandle, xpath, "c")) {
+            m_c = *value;
         }
         else {
             LOG(ERROR) << "Required attribute c is missing at xpath " << xpath;
         }
 
         // read element a
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/a")) {
-            m_a = tixi::TixiGetElement<int>(tixiHandle, xpath + "/a");
+        if (const boost::optional<int> value = tixi::TixiTryGetElement<int>(tixiHandle, xpath + "/a")) {
+            m_a = *value;
         }
         else {
             LOG(ERROR) << "Required element a is missing at xpath " << xpath;
         }
 
         // read element b
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/b")) {
-            m_b = tixi::TixiGetElement<int>(tixiHandle, xpath + "/b");
+        if (const boost::optional<int> value = tixi::TixiTryGetElement<int>(tixiHandle, xpath + "/b")) {
+            m_b = *value;
         }
         else {
             LOG(ERROR) << "Required element b is missing at xpath " << xpath;
@@ -156,15 +156,15 @@ namespace generated
     void CPACSRoot::WriteCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath) const
     {
         // write attribute c
-        tixi::TixiSaveAttribute(tixiHandle, xpath, "c", m_c);
+        tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "c", m_c);
 
         // write element a
-        tixi::TixiCreateElementIfNotExists(tixiHandle, xpath + "/a");
-        tixi::TixiSaveElement(tixiHandle, xpath + "/a", m_a);
+        tixi::TixiCreateElementIfNotExistsIndexed(tixiHandle, xpath + "/a");
+        tixi::TixiSaveElementIndexed(tixiHandle, xpath + "/a", m_a);
 
         // write element b
-        tixi::TixiCreateElementIfNotExists(tixiHandle, xpath + "/b");
-        tixi::TixiSaveElement(tixiHandle, xpath + "/b", m_b);
+        tixi::TixiCreateElementIfNotExistsIndexed(tixiHandle, xpath + "/b");
+        tixi::TixiSaveElementIndexed(tixiHandle, xpath + "/b", m_b);
 
     }
 
@@ -157,59 +157,59 @@ namespace generated
     void CPACSRoot::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         // read element a
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/a")) {
-            m_a = tixi::TixiGetElement<int>(tixiHandle, xpath + "/a");
+        if (const boost::optional<int> value = tixi::TixiTryGetElement<int>(tixiHandle, xpath + "/a")) {
+            m_a = *value;
         }
         else {
             LOG(ERROR) << "Required element a is missing at xpath " << xpath;
         }
 
         // read element b
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/b")) {
-            m_b = tixi::TixiGetElement<int>(tixiHandle, xpath + "/b");
+        if (const boost::optional<int> value = tixi::TixiTryGetElement<int>(tixiHandle, xpath + "/b")) {
+            m_b = *value;
         }
 
         // read element c
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/c")) {
-            m_c = tixi::TixiGetElement<int>(tixiHandle, xpath + "/c");
+        if (const boost::optional<int> value = tixi::TixiTryGetElement<int>(tixiHandle, xpath + "/c")) {
+            m_c = *value;
         }
         else {
             LOG(ERROR) << "Required element c is missing at xpath " << xpath;
         }
 
         // read element d
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/d")) {
-            m_d = tixi::TixiGetElement<int>(tixiHandle, xpath + "/d");
+        if (const boost::optional<int> value = tixi::TixiTryGetElement<int>(tixiHandle, xpath + "/d")) {
+            m_d = *value;
         }
         else {
             LOG(ERROR) << "Required element d is missing at xpath " << xpath;
         }
 
         // read element e
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/e")) {
+        if (tixi::TixiCheckElementIndexed(tixiHandle, xpath + "/e")) {
             tixi::TixiReadElements(tixiHandle, xpath + "/e", m_es, 1, tixi::xsdUnbounded);
         }
 
         // read element f
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/f")) {
-            m_f = tixi::TixiGetElement<int>(tixiHandle, xpath + "/f");
+        if (const boost::optional<int> value = tixi::TixiTryGetElement<int>(tixiHandle, xpath + "/f")) {
+            m_f = *value;
         }
 
         // read element g
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/g")) {
+        if (tixi::TixiCheckElementIndexed(tixiHandle, xpath + "/g")) {
             tixi::TixiReadElements(tixiHandle, xpath + "/g", m_gs, 0, tixi::xsdUnbounded);
         }
 
         // read element h
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/h")) {
-            m_h = tixi::TixiGetElement<int>(tixiHandle, xpath + "/h");
+        if (const boost::optional<int> value = tixi::TixiTryGetElement<int>(tixiHandle, xpath + "/h")) {
+            m_h = *value;
         }
         else {
             LOG(ERROR) << "Required element h is missing at xpath " << xpath;
         }
 
         // read element i
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/i")) {
+        if (tixi::TixiCheckElementIndexed(tixiHandle, xpath + "/i")) {
             tixi::TixiReadElements(tixiHandle, xpath + "/i", m_is, 1, tixi::xsdUnbounded);
         }
 
@@ -221,26 +221,26 @@ namespace generated
 
         // write element a
         tixi::TixiCreateSequenceElementIfNotExists(tixiHandle, xpath + "/a", childElemOrder);
-        tixi::TixiSaveElement(tixiHandle, xpath + "/a", m_a);
+        tixi::TixiSaveElementIndexed(tixiHandle, xpath + "/a", m_a);
 
         // write element b
         if (m_b) {
             tixi::TixiCreateSequenceElementIfNotExists(tixiHandle, xpath + "/b", childElemOrder);
-            tixi::TixiSaveElement(tixiHandle, xpath + "/b", *m_b);
+            tixi::TixiSaveElementIndexed(tixiHandle, xpath + "/b", *m_b);
         }
         else {
             if (tixi::TixiCheckElement(tixiHandle, xpath + "/b")) {
-                tixi::TixiRemoveElement(tixiHandle, xpath + "/b");
+                tixi::TixiRemoveElementIndexed(tixiHandle, xpath + "/b");
             }
         }
 
         // write element c
         tixi::TixiCreateSequenceElementIfNotExists(tixiHandle, xpath + "/c", childElemOrder);
-        tixi::TixiSaveElement(tixiHandle, xpath + "/c", m_c);
+        tixi::TixiSaveElementIndexed(tixiHandle, xpath + "/c", m_c);
 
         // write element d
         tixi::TixiCreateSequenceElementIfNotExists(tixiHandle, xpath + "/d", childElemOrder);
-        tixi::TixiSaveElement(tixiHandle, xpath + "/d", m_d);
+        tixi::TixiSaveElementIndexed(tixiHandle, xpath + "/d", m_d);
 
         // write element e
         tixi::TixiSaveElements(tixiHandle, xpath + "/e", m_es);
@@ -248,11 +248,11 @@ namespace generated
         // write element f
         if (m_f) {
             tixi::TixiCreateSequenceElementIfNotExists(tixiHandle, xpath + "/f", childElemOrder);
-            tixi::TixiSaveElement(tixiHandle, xpath + "/f", *m_f);
+            tixi::TixiSaveElementIndexed(tixiHandle, xpath + "/f", *m_f);
         }
         else {
             if (tixi::TixiCheckElement(tixiHandle, xpath + "/f")) {
-                tixi::TixiRemoveElement(tixiHandle, xpath + "/f");
+                tixi::TixiRemoveElementIndexed(tixiHandle, xpath + "/f");
             }
         }
 
@@ -261,7 +261,7 @@ namespace generated
 
         // write element h
         tixi::TixiCreateSequenceElementIfNotExists(tixiHandle, xpath + "/h", childElemOrder);
-        tixi::TixiSaveElement(tixiHandle, xpath + "/h", m_h);
+        tixi::TixiSaveElementIndexed(tixiHandle, xpath + "/h", m_h);
 
         // write element i
         tixi::TixiSaveElements(tixiHandle, xpath + "/i", m_is);
@@ -320,8 +320,8 @@ namespace generated
     void CPACSBase::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         // read attribute uID
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "uID")) {
-            m_uID = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "uID");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "uID")) {
+            m_uID = *value;
             if (m_uID.empty()) {
                 LOG(WARNING) << "Required attribute uID is empty at xpath " << xpath;
             }
@@ -331,8 +331,8 @@ namespace generated
         }
 
         // read simpleContent 
-        if (tixi::TixiCheckElement(tixiHandle, xpath)) {
-            m_value = tixi::TixiGetElement<std::string>(tixiHandle, xpath);
+        if (const boost::optional<std::string> value = tixi::TixiTryGetElement<std::string>(tixiHandle, xpath)) {
+            m_value = *value;
             if (m_value.empty()) {
                 LOG(WARNING) << "Required element  is empty at xpath " << xpath;
             }
@@ -347,10 +347,10 @@ namespace generated
     void CPACSBase::WriteCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath) const
     {
         // write attribute uID
-        tixi::TixiSaveAttribute(tixiHandle, xpath, "uID", m_uID);
+        tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "uID", m_uID);
 
         // write simpleContent 
-        tixi::TixiSaveElement(tixiHandle, xpath, m_value);
+        tixi::TixiSaveElementIndexed(tixiHandle, xpath, m_value);
 
     }
 
@@ -470,8 +470,8 @@ namespace generated
     void CPACSDerived::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         // read attribute uID
-        if (tixi::TixiCheckAttribute(tixiHandle, xpath, "uID")) {
-            m_uID = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "uID");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetAttribute<std::string>(tixiHandle, xpath, "uID")) {
+            m_uID = *value;
             if (m_uID.empty()) {
                 LOG(WARNING) << "Required attribute uID is empty at xpath " << xpath;
             }
@@ -481,8 +481,8 @@ namespace generated
         }
 
         // read simpleContent 
-        if (tixi::TixiCheckElement(tixiHandle, xpath)) {
-            m_value = tixi::TixiGetElement<std::string>(tixiHandle, xpath);
+        if (const boost::optional<std::string> value = tixi::TixiTryGetElement<std::string>(tixiHandle, xpath)) {
+            m_value = *value;
             if (m_value.empty()) {
                 LOG(WARNING) << "Required element  is empty at xpath " << xpath;
             }
@@ -497,10 +497,10 @@ namespace generated
     void CPACSDerived::WriteCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath) const
     {
         // write attribute uID
-        tixi::TixiSaveAttribute(tixiHandle, xpath, "uID", m_uID);
+        tixi::TixiSaveAttributeIndexed(tixiHandle, xpath, "uID", m_uID);
 
         // write simpleContent 
-        tixi::TixiSaveElement(tixiHandle, xpath, m_value);
+        tixi::TixiSaveElementIndexed(tixiHandle, xpath, m_value);
 
     }
 
@@ -602,7 +602,7 @@ namespace generated
     void CPACSRoot::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         // read element base
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/base")) {
+        if (tixi::TixiCheckElementIndexed(tixiHandle, xpath + "/base")) {
             m_base.ReadCPACS(tixiHandle, xpath + "/base");
         }
         else {
@@ -610,7 +610,7 @@ namespace generated
         }
 
         // read element derived
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/derived")) {
+        if (tixi::TixiCheckElementIndexed(tixiHandle, xpath + "/derived")) {
             m_derived.ReadCPACS(tixiHandle, xpath + "/derived");
         }
         else {
@@ -148,8 +148,8 @@ namespace generated
     void CPACSRoot::ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath)
     {
         // read element singleUidRef
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/singleUidRef")) {
-            m_singleUidRef = tixi::TixiGetElement<std::string>(tixiHandle, xpath + "/singleUidRef");
+        if (const boost::optional<std::string> value = tixi::TixiTryGetElement<std::string>(tixiHandle, xpath + "/singleUidRef")) {
+            m_singleUidRef = *value;
             if (m_singleUidRef->empty()) {
                 LOG(WARNING) << "Optional element singleUidRef is present but empty at xpath " << xpath;
             }
@@ -157,7 +157,7 @@ namespace generated
         }
 
         // read element multiUidRefs
-        if (tixi::TixiCheckElement(tixiHandle, xpath + "/multiUidRefs")) {
+        if (tixi::TixiCheckElementIndexed(tixiHandle, xpath + "/multiUidRefs")) {
             tixi::TixiReadElements(tixiHandle, xpath + "/multiUidRefs", m_multiUidRefs, 0, tixi::xsdUnbounded);
             if (m_uidMgr) {
                 for (std::vector<std::string>::iterator it = m_multiUidRefs.begin(); it != m_multiUidRefs.end(); ++it) {
@@ -175,11 +175,11 @@ namespace generated
         // write element singleUidRef
         if (m_singleUidRef) {
             tixi::TixiCreateSequenceElementIfNotExists(tixiHandle, xpath + "/singleUidRef", childElemOrder);
-            tixi::TixiSaveElement(tixiHandle, xpath + "/singleUidRef", *m_singleUidRef);
+            tixi::TixiSaveElementIndexed(tixiHandle, xpath + "/singleUidRef", *m_singleUidRef);
         }
         else {
             if (tixi::TixiCheckElement(tixiHandle, xpath + "/singleUidRef")) {
-                tixi::TixiRemoveElement(tixiHandle, xpath + "/singleUidRef");
+                tixi::TixiRemoveElementIndexed(tixiHandle, xpath + "/singleUidRef");
             }
         }
 
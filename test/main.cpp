@@ -1,36 +1,136 @@
 #define BOOST_TEST_MODULE CPACSGenTests
 #include <boost/test/unit_test.hpp>
 
+#include "../src/lib/Arena.h"
 #include "../src/lib/SchemaParser.h"
 #include "../src/lib/TypeSystem.h"
 #include "../src/lib/CodeGen.h"
 #include "../src/lib/Tables.h"
 #include "../src/lib/Filesystem.h"
+#include "../src/lib/GenerationCache.h"
+#include "../src/lib/Logging.h"
+#include "../src/lib/Parallel.h"
+#include "../src/lib/Pipeline.h"
+#include "../src/lib/Profiler.h"
 
 #include "utils.h"
 
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace {
+    // writes everything parsed from a schema, for comparing the results of the parser backends
+    struct SchemaDumper {
+        void operator()(const tigl::xsd::Element& e) const {
+            os << "element " << e.xpath << ' ' << e.name << ' ' << e.type << ' ' << e.minOccurs << ' ' << e.maxOccurs << ' ' << e.defaultValue << ' ' << e.documentation << '\n';
+        }
+        void operator()(const tigl::xsd::Attribute& a) const {
+            os << "attribute " << a.xpath << ' ' << a.name << ' ' << a.type << ' ' << a.defaultValue << ' ' << a.fixed << ' ' << a.optional << ' ' << a.documentation << '\n';
+        }
+        void operator()(const tigl::xsd::Group& g) const {
+            os << "group " << g.xpath << '\n';
+        }
+        void operator()(const tigl::xsd::Any& a) const {
+            os << "any " << a.xpath << '\n';
+        }
+        void operator()(const tigl::xsd::All& a) const {
+            os << "all " << a.xpath << '\n';
+            for (const auto& e : a.elements)
+                (*this)(e);
+        }
+        void operator()(const tigl::xsd::Sequence& s) const {
+            os << "sequence " << s.xpath << '\n';
+            for (const auto& e : s.elements)
+                e.visit(*this);
+        }
+        void operator()(const tigl::xsd::Choice& c) const {
+            os << "choice " << c.xpath << ' ' << c.minOccurs << '\n';
+            for (const auto& e : c.elements)
+                e.visit(*this);
+        }
+        void operator()(const tigl::xsd::SimpleContent& s) const {
+            os << "simplecontent " << s.xpath << ' ' << s.type << '\n';
+        }
+        void operator()(const tigl::xsd::ComplexType& t) const {
+            os << "complextype " << t.xpath << ' ' << t.name << ' ' << t.base << ' ' << t.documentation << '\n';
+            t.content.visit(*this);
+            for (const auto& a : t.attributes)
+                (*this)(a);
+        }
+        void operator()(const tigl::xsd::SimpleType& t) const {
+            os << "simpletype " << t.xpath << ' ' << t.name << ' ' << t.base << '\n';
+            for (const auto& v : t.restrictionValues)
+                os << v << '\n';
+        }
+
+        std::ostream& os;
+    };
+
+    auto dump(const tigl::xsd::SchemaTypes& types) -> std::string {
+        std::ostringstream ss;
+        for (const auto& r : types.roots)
+            ss << "root " << r << '\n';
+        const std::map<std::string, tigl::Variant<tigl::xsd::ComplexType, tigl::xsd::SimpleType>> sorted(types.types.begin(), types.types.end());
+        for (const auto& t : sorted)
+            t.second.visit(SchemaDumper{ ss });
+        return ss.str();
+    }
+
+    // generates code for types in memory and returns the merged files
+    auto generate(const tigl::xsd::SchemaTypes& types, const tigl::Tables& tables, const boost::filesystem::path& dir) -> std::string {
+        tigl::Filesystem fs;
+        const auto typeSystem = tigl::buildTypeSystem(types, tables);
+        genCode(dir.string(), typeSystem, "", tables, fs);
+        std::ostringstream ss;
+        fs.mergeFilesInto(ss);
+        return ss.str();
+    }
+
+    // manifest entries of files written in the second the manifest was written in are not trusted.
+    // Pretends the manifest was written later instead of waiting for the clock
+    void ageFilesBeforeManifest(const boost::filesystem::path& manifest) {
+        boost::filesystem::last_write_time(manifest, std::time(nullptr) + 10);
+    }
+}
+
 void runTest() {
     const auto testDir = ::testDir();
     const auto schemaFile = testDir / "schema.xsd";
     const auto refFile = testDir / "ref.cpp";
     const auto resultFile = testDir / "result.cpp";
 
-    tigl::Filesystem fs;
+    // generated code must not depend on the number of threads generating it
+    for (const auto jobs : { 1u, 4u }) {
+        tigl::Filesystem fs;
 
-    const tigl::Tables tables(testDir.string());
-    auto types = tigl::xsd::parseSchema(schemaFile.string());
-    const auto& typeSystem = tigl::buildTypeSystem(types, tables);
-    genCode(testDir.string(), typeSystem, "", tables, fs);
+        const tigl::Tables tables(testDir.string());
+        auto types = tigl::xsd::parseSchema(schemaFile.string());
+        const auto& typeSystem = tigl::buildTypeSystem(types, tables);
+        genCode(testDir.string(), typeSystem, "", tables, fs, jobs);
 
-    fs.mergeFilesInto(resultFile);
-    fs.flushToDisk();
+        // merging in memory and streaming the merged files to disk must give the same result
+        if (jobs == 1) {
+            fs.mergeFilesInto(resultFile);
+            fs.flushToDisk(jobs);
+        } else {
+            std::ofstream f(resultFile.string());
+            fs.mergeFilesInto(f);
+        }
 
-    const auto ref = readTextFile(refFile);
-    const auto result = readTextFile(resultFile);
-    if (ref != result)
-        BOOST_TEST_ERROR("ref and result mismatch. please diff files in filesystem");
-    else
-        boost::filesystem::remove(resultFile);
+        const auto ref = readTextFile(refFile);
+        const auto result = readTextFile(resultFile);
+        if (ref != result) {
+            BOOST_TEST_ERROR("ref and result mismatch with " << jobs << " jobs. please diff files in filesystem");
+            return;
+        } else
+            boost::filesystem::remove(resultFile);
+    }
 }
 
 BOOST_AUTO_TEST_CASE(sequence) {
@@ -84,3 +184,537 @@ BOOST_AUTO_TEST_CASE(collapsedifferentenums) {
 BOOST_AUTO_TEST_CASE(optionalchoice) {
     runTest();
 }
+
+BOOST_AUTO_TEST_CASE(recursiveuid) {
+    // NodeType contains itself, the analysis must terminate and still find the uid below it
+    const auto testDir = ::testDir();
+    const tigl::Tables tables(testDir.string());
+    const auto typeSystem = tigl::buildTypeSystem(tigl::xsd::parseSchema((testDir / "schema.xsd").string()), tables);
+
+    BOOST_CHECK(typeSystem.findClass("CPACSLeaf")->requiresUidManager);
+    BOOST_CHECK(typeSystem.findClass("CPACSNode")->requiresUidManager);
+    BOOST_CHECK(typeSystem.findClass("CPACSRoot")->requiresUidManager);
+    BOOST_CHECK(!typeSystem.findClass("CPACSPlain")->requiresUidManager);
+
+    // fields refer to their types by id
+    const auto& node = *typeSystem.findClass("CPACSNode");
+    for (const auto& f : node.fields) {
+        const auto c = typeSystem.findClass(f.typeId);
+        BOOST_REQUIRE(c != nullptr);
+        BOOST_CHECK_EQUAL(c->name, f.typeName);
+        BOOST_CHECK_EQUAL(typeSystem.symbols.name(f.typeId), f.typeName);
+    }
+
+    // dependencies are sorted by name and include the class itself for the recursion
+    BOOST_REQUIRE_EQUAL(node.deps.children.size(), 2);
+    BOOST_CHECK_EQUAL(node.deps.children[0]->name, "CPACSLeaf");
+    BOOST_CHECK_EQUAL(node.deps.children[1], &node);
+    BOOST_CHECK_EQUAL(node.deps.parents.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(symboltable) {
+    tigl::SymbolTable symbols;
+    const auto a = symbols.intern("CPACSA");
+    const auto b = symbols.intern("CPACSB");
+    BOOST_CHECK_EQUAL(a, 0);
+    BOOST_CHECK_EQUAL(b, 1);
+    BOOST_CHECK_EQUAL(symbols.intern("CPACSA"), a);
+    BOOST_CHECK_EQUAL(symbols.find("CPACSB"), b);
+    BOOST_CHECK_EQUAL(symbols.find("CPACSC"), tigl::c_noTypeId);
+    BOOST_CHECK_EQUAL(symbols.name(b), "CPACSB");
+    BOOST_CHECK_EQUAL(symbols.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(variant) {
+    using V = tigl::Variant<int, std::string>;
+    V empty;
+    BOOST_CHECK(!empty.is<int>() && !empty.is<std::string>());
+
+    V v = std::string("text");
+    BOOST_CHECK(v.is<std::string>());
+    BOOST_CHECK_EQUAL(v.as<std::string>(), "text");
+    BOOST_CHECK_THROW(v.as<int>(), std::logic_error);
+
+    V copy = v;
+    V moved = std::move(v);
+    BOOST_CHECK_EQUAL(copy.as<std::string>(), "text");
+    BOOST_CHECK_EQUAL(moved.as<std::string>(), "text");
+
+    struct ToString {
+        void operator()(int i) const { result = std::to_string(i); }
+        void operator()(const std::string& s) const { result = s; }
+        std::string& result;
+    };
+    moved = 42;
+    BOOST_CHECK(moved.is<int>());
+    std::string visited;
+    moved.visit(ToString{ visited });
+    BOOST_CHECK_EQUAL(visited, "42");
+    copy.visit(ToString{ visited });
+    BOOST_CHECK_EQUAL(visited, "text");
+    empty.visit(ToString{ visited });
+    BOOST_CHECK_EQUAL(visited, "text");
+
+    copy = empty;
+    BOOST_CHECK(!copy.is<std::string>());
+
+    // assigning the held value or a part of it to the variant itself
+    tigl::Variant<std::string, std::vector<std::string>> self = std::string("self");
+    self = self.as<std::string>();
+    BOOST_CHECK_EQUAL(self.as<std::string>(), "self");
+    self = std::vector<std::string>{ "a", "b" };
+    self = self.as<std::vector<std::string>>()[1];
+    BOOST_CHECK_EQUAL(self.as<std::string>(), "b");
+    self = std::vector<std::string>{ "c" };
+    self = std::move(self.as<std::vector<std::string>>()[0]);
+    BOOST_CHECK_EQUAL(self.as<std::string>(), "c");
+    static_assert(std::is_nothrow_move_constructible<V>::value, "moving a Variant of nothrow movable types must not throw");
+}
+
+BOOST_AUTO_TEST_CASE(arena) {
+    tigl::Arena arena(64);
+    const auto a = arena.intern(std::string("CPACSA"));
+    BOOST_CHECK_EQUAL(a, "CPACSA");
+    BOOST_CHECK_EQUAL(arena.intern("CPACSA").data(), a.data());
+    BOOST_CHECK(arena.intern("").empty());
+
+    // interned strings stay valid while the arena grows
+    for (int i = 0; i < 5000; i++)
+        BOOST_CHECK_EQUAL(arena.intern("value" + std::to_string(i)), "value" + std::to_string(i));
+    BOOST_CHECK_EQUAL(arena.intern("value42").data(), arena.intern(std::string("value42")).data());
+    BOOST_CHECK_EQUAL(a, "CPACSA");
+    BOOST_CHECK_GT(arena.blockCount(), 1);
+
+    arena.intern("x"); // misalign the next allocation
+    const std::vector<double> values{ 1, 2, 3 };
+    const auto stored = arena.store(std::begin(values), std::end(values));
+    BOOST_CHECK_EQUAL(stored.size(), 3);
+    BOOST_CHECK_EQUAL(stored[2], 3);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(stored.begin()) % alignof(double), 0);
+}
+
+BOOST_AUTO_TEST_CASE(deterministicorder) {
+    // the generated code must not depend on the iteration order of the parsed types
+    const auto dataDir = testDir().parent_path();
+    std::mt19937 rng(42);
+    for (const auto name : { "collapsedifferentenums", "uidinbasetype", "choice", "recursiveuid", "typenamecollision" }) {
+        const auto dir = dataDir / name;
+        const tigl::Tables tables(dir.string());
+        const auto types = tigl::xsd::parseSchema((dir / "schema.xsd").string());
+        const auto reference = generate(types, tables, dir);
+
+        std::vector<std::pair<tigl::xsd::String, tigl::Variant<tigl::xsd::ComplexType, tigl::xsd::SimpleType>>> entries(types.types.begin(), types.types.end());
+        for (std::size_t i = 1; i <= 5; i++) {
+            std::shuffle(std::begin(entries), std::end(entries), rng);
+            tigl::xsd::SchemaTypes shuffled;
+            shuffled.roots = types.roots;
+            shuffled.types.reserve(entries.size() * i); // different bucket counts change the iteration order as well
+            for (const auto& e : entries)
+                shuffled.types.insert(e);
+            BOOST_CHECK_MESSAGE(generate(shuffled, tables, dir) == reference, "output of " << name << " depends on the type order");
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(parserbackends) {
+    // both parser backends must read all test schemas identically
+    for (const auto& e : boost::filesystem::directory_iterator(testDir().parent_path())) {
+        const auto schemaFile = e.path() / "schema.xsd";
+        if (!boost::filesystem::exists(schemaFile))
+            continue;
+        BOOST_TEST_CONTEXT(schemaFile) {
+            const auto tixi = dump(tigl::xsd::parseSchema(schemaFile.string(), tigl::xsd::ParserBackend::Tixi));
+            const auto libxml2 = dump(tigl::xsd::parseSchema(schemaFile.string(), tigl::xsd::ParserBackend::LibXml2));
+            BOOST_CHECK(!tixi.empty());
+            BOOST_CHECK_EQUAL(tixi, libxml2);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(orderedpasses) {
+    const auto dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    boost::filesystem::create_directories(dir);
+    const auto shared = dir / "shared.h";
+
+    // passes generate concurrently, but are taken over in order, so the last pass writing a file wins
+    struct PassState {
+        std::size_t index;
+        std::unique_ptr<tigl::Filesystem> files;
+    };
+    tigl::Filesystem fs;
+    std::vector<std::size_t> order;
+    tigl::Pipeline<PassState> pipeline(2);
+    pipeline.addStage("generate", [&](PassState& state) {
+        state.files.reset(new tigl::Filesystem);
+        state.files->newFile(shared).stream() << state.index;
+        state.files->newFile(dir / (std::to_string(state.index) + ".h")).stream() << state.index;
+    }, 4);
+    pipeline.addStage("flush", [&](PassState& state) {
+        order.push_back(state.index);
+        fs.takeFilesFrom(*state.files);
+    });
+    std::vector<PassState> passes;
+    for (std::size_t i = 0; i < 8; i++)
+        passes.push_back(PassState{ i, nullptr });
+    pipeline.run(std::move(passes), 4);
+    fs.flushToDisk(4);
+
+    BOOST_CHECK_EQUAL(order.size(), 8);
+    BOOST_CHECK(std::is_sorted(std::begin(order), std::end(order)));
+    BOOST_CHECK_EQUAL(readTextFile(shared), "7");
+    BOOST_CHECK_EQUAL(readTextFile(dir / "3.h"), "3");
+
+    boost::filesystem::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(pipeline) {
+    // items pass all stages in order, with stages working on different items at the same time
+    for (const auto jobs : { 1u, 2u }) {
+        tigl::Pipeline<std::string> pipeline(2);
+        std::vector<std::string> first, second;
+        pipeline.addStage("first", [&](std::string& s) {
+            s += 'a';
+            first.push_back(s);
+        });
+        pipeline.addStage("second", [&](std::string& s) {
+            s += 'b';
+            second.push_back(s);
+        });
+        pipeline.run({ "0", "1", "2", "3", "4", "5" }, jobs);
+
+        BOOST_CHECK_EQUAL(first.size(), 6);
+        BOOST_CHECK_EQUAL(second.size(), 6);
+        BOOST_CHECK_EQUAL(first[3], "3a");
+        BOOST_CHECK_EQUAL(second[5], "5ab");
+
+        const auto& stats = pipeline.stats();
+        BOOST_REQUIRE_EQUAL(stats.size(), 2);
+        BOOST_CHECK_EQUAL(stats[0].name, "first");
+        BOOST_CHECK_EQUAL(stats[1].items, 6);
+        BOOST_CHECK_LE(stats[1].maxQueueDepth, 2);
+    }
+
+    // a stage with multiple workers processes items at the same time, never running more stage functions than jobs,
+    // and hands them on in order
+    {
+        tigl::Pipeline<int> pipeline(2);
+        std::mutex mutex;
+        int running = 0, maxRunning = 0;
+        std::vector<int> handedOn;
+        pipeline.addStage("work", [&](int& i) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                maxRunning = std::max(maxRunning, ++running);
+            }
+            // later items finish first
+            std::this_thread::sleep_for(std::chrono::milliseconds(20 - 2 * i));
+            std::lock_guard<std::mutex> lock(mutex);
+            running--;
+        }, 4);
+        pipeline.addStage("collect", [&](int& i) {
+            handedOn.push_back(i);
+        });
+        pipeline.run({ 0, 1, 2, 3, 4, 5, 6, 7 }, 3);
+
+        const std::vector<int> expected{ 0, 1, 2, 3, 4, 5, 6, 7 };
+        BOOST_CHECK_EQUAL_COLLECTIONS(std::begin(handedOn), std::end(handedOn), std::begin(expected), std::end(expected));
+        BOOST_CHECK_LE(maxRunning, 3);
+        BOOST_CHECK_GT(maxRunning, 1);
+        BOOST_CHECK_EQUAL(pipeline.stats()[0].workers, 4);
+        BOOST_CHECK_EQUAL(pipeline.stats()[0].items, 8);
+    }
+
+    // an exception stops all stages and is rethrown
+    for (const auto workers : { 1u, 3u }) {
+        tigl::Pipeline<int> pipeline(1);
+        std::size_t consumed = 0;
+        pipeline.addStage("fail", [](int& i) {
+            if (i == 5)
+                throw std::runtime_error("stage failed");
+        }, workers);
+        pipeline.addStage("consume", [&](int&) {
+            consumed++;
+        });
+        BOOST_CHECK_THROW(pipeline.run({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }, 2), std::runtime_error);
+        BOOST_CHECK_LE(consumed, 5);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(manifest) {
+    const auto dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    boost::filesystem::create_directories(dir);
+    const auto file = dir / "file.h";
+    const auto manifest = dir / "manifest";
+
+    struct Counters {
+        std::size_t newlywritten, overwritten, skipped, skippedByManifest;
+    };
+    auto flush = [&](const std::string& content) {
+        tigl::Filesystem fs;
+        fs.useManifest(manifest);
+        fs.newFile(file).stream() << content;
+        fs.flushToDisk();
+        ageFilesBeforeManifest(manifest);
+        return Counters{ fs.newlywritten, fs.overwritten, fs.skipped, fs.skippedByManifest };
+    };
+
+    // no manifest yet
+    auto fs = flush("a");
+    BOOST_CHECK_EQUAL(fs.newlywritten, 1);
+
+    // unchanged content is skipped without reading the file
+    fs = flush("a");
+    BOOST_CHECK_EQUAL(fs.skipped, 1);
+    BOOST_CHECK_EQUAL(fs.skippedByManifest, 1);
+
+    // changed content is written
+    fs = flush("b");
+    BOOST_CHECK_EQUAL(fs.overwritten, 1);
+
+    // a file modified behind the manifest's back is compared by content
+    {
+        std::ofstream f(file.string());
+        f << "modified";
+    }
+    boost::filesystem::last_write_time(file, boost::filesystem::last_write_time(file) + 10);
+    fs = flush("b");
+    BOOST_CHECK_EQUAL(fs.overwritten, 1);
+    BOOST_CHECK_EQUAL(readTextFile(file), "b");
+
+    // a file modified in the second the manifest was written, keeping its size and time, is compared by content
+    fs = flush("b");
+    BOOST_CHECK_EQUAL(fs.skippedByManifest, 1);
+    {
+        const auto mtime = boost::filesystem::last_write_time(file);
+        {
+            std::ofstream f(file.string());
+            f << "c";
+        }
+        boost::filesystem::last_write_time(file, mtime);
+        boost::filesystem::last_write_time(manifest, mtime);
+    }
+    {
+        tigl::Filesystem racy;
+        racy.useManifest(manifest);
+        BOOST_CHECK(!racy.isUnmodifiedSinceLastFlush(file));
+        racy.newFile(file).stream() << "b";
+        racy.flushToDisk();
+        BOOST_CHECK_EQUAL(racy.overwritten, 1);
+        BOOST_CHECK_EQUAL(readTextFile(file), "b");
+    }
+
+    // a missing manifest falls back to comparing by content
+    boost::filesystem::remove(manifest);
+    fs = flush("b");
+    BOOST_CHECK_EQUAL(fs.skipped, 1);
+    BOOST_CHECK_EQUAL(fs.skippedByManifest, 0);
+
+    boost::filesystem::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(generationcache) {
+    const auto dataDir = testDir().parent_path() / "custombasetype";
+    const auto dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    const auto out = dir / "out";
+    const auto fresh = dir / "fresh";
+    boost::filesystem::create_directories(out);
+    boost::filesystem::create_directories(fresh);
+
+    struct Counters {
+        std::size_t written, reusedFiles;
+    };
+    auto generate = [&](const boost::filesystem::path& tablesDir, const boost::filesystem::path& outDir, bool useCache) {
+        tigl::Filesystem fs;
+        fs.useManifest(outDir / ".manifest");
+        tigl::GenerationCache cache(outDir / ".cache", 42, fs);
+        auto pass = cache.beginPass("schema.xsd", 0);
+
+        const tigl::Tables tables(tablesDir.string());
+        auto types = tigl::xsd::parseSchema((dataDir / "schema.xsd").string());
+        const auto& typeSystem = tigl::buildTypeSystem(types, tables);
+        genCode(outDir.string(), typeSystem, "", tables, fs, 1, useCache ? &pass : nullptr);
+
+        fs.flushToDisk();
+        cache.save();
+        ageFilesBeforeManifest(outDir / ".manifest");
+        return Counters{ fs.newlywritten + fs.overwritten + fs.skipped, cache.reusedFiles };
+    };
+    auto sameAsFresh = [&](const boost::filesystem::path& tablesDir) {
+        generate(tablesDir, fresh, false);
+        for (const auto& e : boost::filesystem::directory_iterator(fresh))
+            if (e.path().extension() == ".h" || e.path().extension() == ".cpp")
+                BOOST_CHECK_EQUAL(readTextFile(e.path()), readTextFile(out / e.path().filename()));
+    };
+
+    // first run generates everything
+    auto c = generate(dataDir, out, true);
+    BOOST_CHECK_GT(c.written, 0);
+    BOOST_CHECK_EQUAL(c.reusedFiles, 0);
+    const auto fileCount = c.written;
+
+    // unchanged inputs reuse all files without generating them
+    c = generate(dataDir, out, true);
+    BOOST_CHECK_EQUAL(c.written, 0);
+    BOOST_CHECK_EQUAL(c.reusedFiles, fileCount);
+    sameAsFresh(dataDir);
+
+    // without the custom types table, the customized classes and the classes referring to them are generated again
+    c = generate(dir, out, true);
+    BOOST_CHECK_GT(c.written, 0);
+    BOOST_CHECK_EQUAL(c.written + c.reusedFiles, fileCount);
+    sameAsFresh(dir);
+
+    // a different generator discards the cache
+    {
+        tigl::Filesystem fs;
+        fs.useManifest(out / ".manifest");
+        tigl::GenerationCache cache(out / ".cache", 43, fs);
+        auto pass = cache.beginPass("schema.xsd", 0);
+        BOOST_CHECK(!pass.reuse(out / "CPACSRoot.h", 0));
+        BOOST_CHECK(!cache.reusePass("schema.xsd", 0));
+    }
+
+    boost::filesystem::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(streaming) {
+    const auto dataDir = testDir().parent_path() / "custombasetype";
+    const auto dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    const auto streamed = dir / "streamed";
+    const auto buffered = dir / "buffered";
+    boost::filesystem::create_directories(streamed);
+    boost::filesystem::create_directories(buffered);
+
+    const tigl::Tables tables(dataDir.string());
+    auto types = tigl::xsd::parseSchema((dataDir / "schema.xsd").string());
+    const auto& typeSystem = tigl::buildTypeSystem(types, tables);
+
+    {
+        tigl::Filesystem fs;
+        genCode(buffered.string(), typeSystem, "", tables, fs, 4);
+        BOOST_CHECK_EQUAL(fs.newlywritten, 0);
+        fs.flushToDisk();
+    }
+
+    // files are written while they are generated, nothing is left for flushToDisk
+    tigl::Filesystem fs;
+    fs.setStreaming(true);
+    genCode(streamed.string(), typeSystem, "", tables, fs, 4);
+    const auto written = fs.newlywritten;
+    BOOST_CHECK_GT(written, 0);
+    fs.flushToDisk();
+    BOOST_CHECK_EQUAL(fs.newlywritten, written);
+
+    for (const auto& e : boost::filesystem::directory_iterator(buffered))
+        BOOST_CHECK_EQUAL(readTextFile(e.path()), readTextFile(streamed / e.path().filename()));
+
+    // a pass generating into its own Filesystem streams its files through the shared one before genCode returns
+    const auto pass = dir / "pass";
+    boost::filesystem::create_directories(pass);
+    tigl::Filesystem shared;
+    shared.setStreaming(true);
+    {
+        tigl::Filesystem passFs;
+        passFs.streamInto(shared);
+        genCode(pass.string(), typeSystem, "", tables, passFs, 4);
+        BOOST_CHECK_EQUAL(shared.newlywritten, written);
+        for (const auto& e : boost::filesystem::directory_iterator(buffered))
+            BOOST_CHECK_EQUAL(readTextFile(e.path()), readTextFile(pass / e.path().filename()));
+        shared.takeFilesFrom(passFs);
+        shared.flushToDisk();
+        BOOST_CHECK_EQUAL(shared.newlywritten, written);
+    }
+
+    // files closed before streaming starts are flushed when it starts, files still open when they are closed
+    {
+        tigl::Filesystem passFs;
+        auto& closed = passFs.newFile(pass / "closed.h");
+        closed.stream() << "closed";
+        passFs.closeFile(closed);
+        auto& open = passFs.newFile(pass / "open.h");
+        open.stream() << "open";
+        BOOST_CHECK(!boost::filesystem::exists(pass / "closed.h"));
+        passFs.streamInto(shared);
+        BOOST_CHECK_EQUAL(readTextFile(pass / "closed.h"), "closed");
+        BOOST_CHECK(!boost::filesystem::exists(pass / "open.h"));
+        passFs.closeFile(open);
+        BOOST_CHECK_EQUAL(readTextFile(pass / "open.h"), "open");
+    }
+
+    boost::filesystem::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(profiler) {
+    // phases nested into buildTypeSystem are recorded with the pass of the enclosing phase
+    const auto dir = testDir().parent_path() / "collapsedifferentenums";
+    const tigl::Tables tables(dir.string());
+    auto& profiler = tigl::Profiler::instance();
+    profiler.enable();
+    {
+        tigl::ProfilePhase phase("buildTypeSystem", "profiler");
+        tigl::buildTypeSystem(tigl::xsd::parseSchema((dir / "schema.xsd").string()), tables);
+    }
+
+    std::map<std::string, tigl::PhaseRecord> records;
+    for (const auto& r : profiler.records())
+        if (r.pass == "profiler")
+            records[r.name] = r;
+    for (const auto name : { "buildTypeSystem", "build", "collapseEnums", "buildDependencies", "runPruneList", "prefixClashedEnumValues" })
+        BOOST_CHECK_MESSAGE(records.count(name) == 1, "phase " << name << " not recorded");
+    BOOST_CHECK_EQUAL(records["buildTypeSystem"].depth + 1, records["collapseEnums"].depth);
+    BOOST_CHECK_GE(records["buildTypeSystem"].wallSeconds, records["collapseEnums"].wallSeconds);
+    BOOST_CHECK_GT(records["buildTypeSystem"].peakRss, 0);
+
+    const auto trace = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    profiler.writeChromeTrace(trace.string());
+    BOOST_CHECK(readTextFile(trace).find("\"name\": \"collapseEnums profiler\"") != std::string::npos);
+    boost::filesystem::remove(trace);
+}
+
+BOOST_AUTO_TEST_CASE(logging) {
+    // the log file receives messages hidden on the console, one JSON object per line
+    const auto file = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    auto& logger = tigl::Logger::instance();
+    logger.setConsoleLevel(tigl::LogLevel::Warning);
+    logger.openFile(file.string());
+    BOOST_CHECK(logger.enabled(tigl::LogLevel::Debug));
+    tigl::log(tigl::LogLevel::Debug) << "\tpruning " << "\"CPACSWing\"";
+    logger.closeFile();
+    BOOST_CHECK(!logger.enabled(tigl::LogLevel::Info));
+    logger.setConsoleLevel(tigl::LogLevel::Info);
+
+    const auto content = readTextFile(file);
+    BOOST_CHECK(content.find("\"level\": \"debug\", \"message\": \"\\tpruning \\\"CPACSWing\\\"\" }\n") != std::string::npos);
+    boost::filesystem::remove(file);
+}
+
+BOOST_AUTO_TEST_CASE(prunelist) {
+    // every class and enum records why it was kept or pruned
+    const auto testDir = ::testDir();
+    const tigl::Tables tables(testDir.string());
+    const auto typeSystem = tigl::buildTypeSystem(tigl::xsd::parseSchema((testDir / "schema.xsd").string()), tables);
+
+    auto decision = [&](const std::string& name) {
+        if (const auto c = typeSystem.findClass(name))
+            return c->pruneDecision;
+        return typeSystem.findEnum(name)->pruneDecision;
+    };
+    auto check = [&](const std::string& name, tigl::PruneReason reason, const std::string& reachedFrom) {
+        const auto d = decision(name);
+        BOOST_CHECK_MESSAGE(d.reason == reason, name << " is " << toString(d.reason) << " instead of " << toString(reason));
+        BOOST_CHECK_EQUAL(d.reachedFrom == tigl::c_noTypeId ? "" : typeSystem.symbols.name(d.reachedFrom), reachedFrom);
+    };
+    check("CPACSRoot",        tigl::PruneReason::Root,        "");
+    check("CPACSNode",        tigl::PruneReason::Reachable,   "CPACSRoot");
+    check("CPACSLeaf",        tigl::PruneReason::Reachable,   "CPACSNode");
+    check("CPACSKind",        tigl::PruneReason::Reachable,   "CPACSRoot");
+    check("CPACSPruned",      tigl::PruneReason::PruneList,   "CPACSRoot");
+    check("CPACSBelowPruned", tigl::PruneReason::Unreachable, "");
+    check("CPACSMode",        tigl::PruneReason::Unreachable, "");
+    check("CPACSOrphan",      tigl::PruneReason::Unreachable, "");
+
+    BOOST_CHECK(!typeSystem.findClass("CPACSNode")->pruned);
+    BOOST_CHECK(typeSystem.findClass("CPACSBelowPruned")->pruned);
+    BOOST_CHECK(typeSystem.findEnum("CPACSMode")->pruned);
+    BOOST_CHECK_EQUAL(typeSystem.findClass("CPACSRoot")->fields.size(), 2); // node and kind, pruned was removed
+}
@@ -0,0 +1,322 @@
+#include <boost/test/unit_test.hpp>
+
+#include "../src/lib/runtime/TixiHelper.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// the runtime is only used by the generated code, instantiate its templates for all fundamental types so they are compiled
+namespace tixi {
+    template boost::optional<std::string> TixiTryGetElement<std::string>(const TixiDocumentHandle&, const std::string&);
+    template boost::optional<double> TixiTryGetElement<double>(const TixiDocumentHandle&, const std::string&);
+    template boost::optional<int> TixiTryGetElement<int>(const TixiDocumentHandle&, const std::string&);
+    template boost::optional<bool> TixiTryGetElement<bool>(const TixiDocumentHandle&, const std::string&);
+    template boost::optional<std::time_t> TixiTryGetElement<std::time_t>(const TixiDocumentHandle&, const std::string&);
+
+    template boost::optional<std::string> TixiTryGetAttribute<std::string>(const TixiDocumentHandle&, const std::string&, const std::string&);
+    template boost::optional<double> TixiTryGetAttribute<double>(const TixiDocumentHandle&, const std::string&, const std::string&);
+    template boost::optional<int> TixiTryGetAttribute<int>(const TixiDocumentHandle&, const std::string&, const std::string&);
+    template boost::optional<bool> TixiTryGetAttribute<bool>(const TixiDocumentHandle&, const std::string&, const std::string&);
+    template boost::optional<std::time_t> TixiTryGetAttribute<std::time_t>(const TixiDocumentHandle&, const std::string&, const std::string&);
+
+    template void TixiReadElements<std::string>(const TixiDocumentHandle&, const std::string&, std::vector<std::string>&, unsigned int, unsigned int);
+    template void TixiReadElements<double>(const TixiDocumentHandle&, const std::string&, std::vector<double>&, unsigned int, unsigned int);
+    template void TixiReadElements<int>(const TixiDocumentHandle&, const std::string&, std::vector<int>&, unsigned int, unsigned int);
+    template void TixiReadElements<bool>(const TixiDocumentHandle&, const std::string&, std::vector<bool>&, unsigned int, unsigned int);
+    template void TixiReadElements<std::time_t>(const TixiDocumentHandle&, const std::string&, std::vector<std::time_t>&, unsigned int, unsigned int);
+
+    template void TixiSaveElements<std::string>(const TixiDocumentHandle&, const std::string&, const std::vector<std::string>&);
+    template void TixiSaveElements<double>(const TixiDocumentHandle&, const std::string&, const std::vector<double>&);
+    template void TixiSaveElements<int>(const TixiDocumentHandle&, const std::string&, const std::vector<int>&);
+    template void TixiSaveElements<bool>(const TixiDocumentHandle&, const std::string&, const std::vector<bool>&);
+    template void TixiSaveElements<std::time_t>(const TixiDocumentHandle&, const std::string&, const std::vector<std::time_t>&);
+}
+
+namespace {
+    // TIXI document read from a string, closed together with its element index on destruction
+    class Document {
+    public:
+        explicit Document(const std::string& xml) {
+            if (tixiImportFromString(xml.c_str(), &m_handle) != SUCCESS)
+                throw std::runtime_error("Failed to import document");
+        }
+
+        ~Document() {
+            tixi::TixiCloseDocumentIndexed(m_handle);
+        }
+
+        Document(const Document&) = delete;
+        Document& operator=(const Document&) = delete;
+
+        auto handle() const -> const TixiDocumentHandle& {
+            return m_handle;
+        }
+
+    private:
+        TixiDocumentHandle m_handle = -1;
+    };
+
+    // minimal generated class, reads and writes its name attribute
+    struct Child {
+        Child(const std::string& parent)
+            : parent(parent) {}
+
+        void ReadCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath) {
+            name = tixi::TixiGetAttribute<std::string>(tixiHandle, xpath, "name");
+        }
+
+        void WriteCPACS(const TixiDocumentHandle& tixiHandle, const std::string& xpath) const {
+            tixi::TixiSaveAttribute(tixiHandle, xpath, "name", name);
+        }
+
+        std::string parent;
+        std::string name;
+    };
+
+    // 2017-01-02T03:04:05 UTC
+    const std::time_t c_timestamp = 1483326245;
+
+    const auto c_valuesXml =
+        "<root created=\"2017-01-02T03:04:05\" count=\"3\" scale=\"1.5\" flag=\"true\">"
+            "<name>n</name>"
+            "<value>2.5</value>"
+            "<count>4</count>"
+            "<flag>false</flag>"
+            "<created>2017-01-02T03:04:05</created>"
+            "<child name=\"a\"/>"
+            "<child name=\"b\"/>"
+            "<child name=\"c\"/>"
+        "</root>";
+}
+
+BOOST_AUTO_TEST_CASE(tixitryget) {
+    const Document doc(c_valuesXml);
+    const auto& h = doc.handle();
+
+    BOOST_CHECK_EQUAL(*tixi::TixiTryGetElement<std::string>(h, "/root/name"), "n");
+    BOOST_CHECK_EQUAL(*tixi::TixiTryGetElement<double>(h, "/root/value"), 2.5);
+    BOOST_CHECK_EQUAL(*tixi::TixiTryGetElement<int>(h, "/root/count"), 4);
+    BOOST_CHECK_EQUAL(*tixi::TixiTryGetElement<bool>(h, "/root/flag"), false);
+    BOOST_CHECK_EQUAL(*tixi::TixiTryGetElement<std::time_t>(h, "/root/created"), c_timestamp);
+    BOOST_CHECK(!tixi::TixiTryGetElement<std::string>(h, "/root/missing"));
+    BOOST_CHECK(!tixi::TixiTryGetElement<std::time_t>(h, "/root/missing"));
+
+    BOOST_CHECK_EQUAL(*tixi::TixiTryGetAttribute<std::time_t>(h, "/root", "created"), c_timestamp);
+    BOOST_CHECK_EQUAL(*tixi::TixiTryGetAttribute<int>(h, "/root", "count"), 3);
+    BOOST_CHECK_EQUAL(*tixi::TixiTryGetAttribute<double>(h, "/root", "scale"), 1.5);
+    BOOST_CHECK_EQUAL(*tixi::TixiTryGetAttribute<bool>(h, "/root", "flag"), true);
+    BOOST_CHECK(!tixi::TixiTryGetAttribute<std::time_t>(h, "/root", "modified"));
+    BOOST_CHECK(!tixi::TixiTryGetAttribute<std::string>(h, "/root/missing", "name"));
+    BOOST_CHECK_EQUAL(tixi::TixiGetAttribute<std::time_t>(h, "/root", "created"), c_timestamp);
+}
+
+BOOST_AUTO_TEST_CASE(tixisavetimet) {
+    const Document doc("<root/>");
+    const auto& h = doc.handle();
+
+    tixi::TixiSaveAttribute(h, "/root", "modified", c_timestamp);
+    tixi::TixiCreateElement(h, "/root/modified");
+    tixi::TixiSaveElement(h, "/root/modified", c_timestamp);
+    BOOST_CHECK_EQUAL(tixi::TixiGetTextAttribute(h, "/root", "modified"), "2017-01-02T03:04:05");
+    BOOST_CHECK_EQUAL(tixi::TixiGetElement<std::time_t>(h, "/root/modified"), c_timestamp);
+}
+
+BOOST_AUTO_TEST_CASE(tixireadelements) {
+    const Document doc(c_valuesXml);
+    const auto& h = doc.handle();
+
+    const std::string parent = "root";
+    const std::vector<std::string> names = { "a", "b", "c" };
+    auto namesOf = [&](const std::vector<std::unique_ptr<Child>>& children) {
+        std::vector<std::string> result;
+        for (const auto& c : children) {
+            BOOST_CHECK_EQUAL(c->parent, parent);
+            result.push_back(c->name);
+        }
+        return result;
+    };
+
+    std::vector<std::unique_ptr<Child>> byXPath;
+    tixi::TixiReadElements(h, "/root/child", byXPath, 1, tixi::xsdUnbounded, parent);
+    const auto byXPathNames = namesOf(byXPath);
+    BOOST_CHECK_EQUAL_COLLECTIONS(byXPathNames.begin(), byXPathNames.end(), names.begin(), names.end());
+
+    std::vector<std::time_t> timestamps;
+    tixi::TixiReadElements(h, "/root/created", timestamps, 0, tixi::xsdUnbounded);
+    BOOST_REQUIRE_EQUAL(timestamps.size(), 1u);
+    BOOST_CHECK_EQUAL(timestamps[0], c_timestamp);
+
+    // writing fewer children removes the remaining ones
+    byXPath.pop_back();
+    byXPath[0]->name = "d";
+    tixi::TixiSaveElements(h, "/root/child", byXPath);
+    BOOST_CHECK_EQUAL(tixi::TixiGetNamedChildrenCount(h, "/root/child"), 2);
+    BOOST_CHECK_EQUAL(tixi::TixiGetTextAttribute(h, "/root/child[1]", "name"), "d");
+}
+
+BOOST_AUTO_TEST_CASE(tixicompiledxpath) {
+    const tixi::TixiCompiledXPath xpath("wings/wing[2]/@uID");
+    BOOST_CHECK(xpath.supported());
+    BOOST_REQUIRE_EQUAL(xpath.steps().size(), 2u);
+    BOOST_CHECK_EQUAL(xpath.steps()[0].name, "wings");
+    BOOST_CHECK_EQUAL(xpath.steps()[0].index, 0);
+    BOOST_CHECK_EQUAL(xpath.steps()[1].name, "wing");
+    BOOST_CHECK_EQUAL(xpath.steps()[1].index, 2);
+    BOOST_CHECK_EQUAL(xpath.attribute(), "uID");
+
+    BOOST_CHECK(tixi::TixiCompiledXPath("/wings/wing").supported());
+    BOOST_CHECK(tixi::TixiCompiledXPath("@uID").supported());
+    BOOST_CHECK(tixi::TixiCompiledXPath("wing[999999999]").supported());
+    for (const auto& unsupported : { "", "wing[0]", "wing[last()]", "wing[99999999999]", "wing[]", "wing[1", "@uID/wing", "../wing", "./wing", "wings//wing", "*", "wing[@uID='a']" })
+        BOOST_CHECK_MESSAGE(!tixi::TixiCompiledXPath(unsupported).supported(), unsupported);
+}
+
+BOOST_AUTO_TEST_CASE(tixielementindexinvalidation) {
+    const Document doc("<root><a/></root>");
+    const auto& h = doc.handle();
+
+    // every modifying runtime function drops the index
+    const std::vector<std::function<void()>> modifications = {
+        [&] { tixi::TixiCreateElementIndexed(h, "/root/b"); },
+        [&] { tixi::TixiCreateElementIfNotExistsIndexed(h, "/root/c"); },
+        [&] { tixi::TixiSaveElementIndexed(h, "/root/c", std::string("text")); },
+        [&] { tixi::TixiSaveElementIndexed(h, "/root/c", c_timestamp); },
+        [&] { tixi::TixiSaveAttributeIndexed(h, "/root/c", "value", 1.5); },
+        [&] { tixi::TixiRemoveAttributeIndexed(h, "/root/c", "value"); },
+        [&] { tixi::TixiRemoveElementIndexed(h, "/root/b"); },
+        [&] { tixi::TixiSaveElements(h, "/root/d", std::vector<int>{ 1, 2 }); },
+        [&] { tixi::TixiCreateSequenceElementIfNotExists(h, "/root/e", { "a", "e", "c" }); },
+    };
+    for (const auto& modify : modifications) {
+        tixi::TixiEnableElementIndex(h, "/root");
+        BOOST_REQUIRE(tixi::TixiGetElementIndex(h));
+        modify();
+        BOOST_CHECK(!tixi::TixiGetElementIndex(h));
+    }
+
+    BOOST_CHECK_EQUAL(tixi::TixiGetChildNodeName(h, "/root", 2), "e");
+    BOOST_CHECK_EQUAL(tixi::TixiGetTextElement(h, "/root/c"), "2017-01-02T03:04:05");
+    BOOST_CHECK_EQUAL(tixi::TixiGetNamedChildrenCount(h, "/root/d"), 2);
+    BOOST_CHECK(!tixi::TixiCheckElement(h, "/root/b"));
+    BOOST_CHECK(!tixi::TixiCheckAttribute(h, "/root/c", "value"));
+
+    // writing fewer or the same children only drops the index if the document changes
+    tixi::TixiEnableElementIndex(h, "/root");
+    tixi::TixiSaveElements(h, "/root/f", std::vector<int>{});
+    BOOST_CHECK(tixi::TixiGetElementIndex(h));
+    tixi::TixiCreateSequenceElementIfNotExists(h, "/root/e", { "a", "e", "c" });
+    BOOST_CHECK(tixi::TixiGetElementIndex(h));
+
+    // the plain names never touch the index, whatever the type of the value
+    tixi::TixiSaveElement(h, "/root/c", c_timestamp);
+    tixi::TixiSaveAttribute(h, "/root/c", "modified", c_timestamp);
+    BOOST_CHECK(tixi::TixiGetElementIndex(h));
+    tixi::TixiInvalidateElementIndex(h);
+    BOOST_CHECK(!tixi::TixiGetElementIndex(h));
+}
+
+BOOST_AUTO_TEST_CASE(tixielementindexlifetime) {
+    TixiDocumentHandle h = -1;
+    BOOST_REQUIRE_EQUAL(tixiImportFromString("<root><a/></root>", &h), SUCCESS);
+    {
+        const tixi::TixiElementIndexScope scope(h, "/root");
+        BOOST_CHECK(tixi::TixiGetElementIndex(h));
+    }
+    BOOST_CHECK(!tixi::TixiGetElementIndex(h));
+
+    // closing the document drops its index
+    tixi::TixiEnableElementIndex(h, "/root");
+    tixi::TixiCloseDocumentIndexed(h);
+    BOOST_CHECK(!tixi::TixiGetElementIndex(h));
+}
+
+BOOST_AUTO_TEST_CASE(tixielementindex) {
+    const Document doc(
+        "<a>"
+            "text"
+            "<wings>"
+                "<wing uID=\"w1\"/>"
+                "<!-- comment -->"
+                "<wing><x/></wing>"
+                "<wing uID=\"w3\"/>"
+            "</wings>"
+            "<name><![CDATA[n]]></name>"
+        "</a>");
+    const auto& h = doc.handle();
+
+    BOOST_CHECK_THROW(tixi::TixiEnableElementIndex(h, "/a/wings"), std::invalid_argument);
+    BOOST_CHECK_THROW(tixi::TixiEnableElementIndex(h, "/a[2]"), std::invalid_argument);
+    BOOST_CHECK(!tixi::TixiGetElementIndex(h));
+
+    tixi::TixiEnableElementIndex(h, "/a");
+    const auto index = tixi::TixiGetElementIndex(h);
+    BOOST_REQUIRE(index);
+    BOOST_CHECK_EQUAL(index->size(), 7u);
+
+    // counts
+    BOOST_CHECK_EQUAL(*index->count("/a/wings/wing"), 3);
+    BOOST_CHECK_EQUAL(*index->count("/a[1]/wings[1]/wing"), 3);
+    BOOST_CHECK_EQUAL(*index->count("/a/wings/wing/@uID"), 2);
+    BOOST_CHECK_EQUAL(*index->count("/a/wings/wing/x"), 1);
+    BOOST_CHECK_EQUAL(*index->count("/a/wings/wing[2]"), 1);
+    BOOST_CHECK_EQUAL(*index->count("/a/wings/wing[4]"), 0);
+    BOOST_CHECK_EQUAL(*index->count("/a/fuselages/fuselage"), 0);
+    BOOST_CHECK_EQUAL(*index->count("/b/wings"), 0);
+    BOOST_CHECK_EQUAL(*index->count("/a/wings/wing", 2), 2);
+
+    // expressions the index cannot answer
+    BOOST_CHECK(!index->count("/a/wings/wing[last()]"));
+    BOOST_CHECK(!index->count("a/wings"));
+    BOOST_CHECK(!index->count("//wing"));
+
+    BOOST_CHECK(*index->checkElement("/a/wings[1]/wing[2]"));
+    BOOST_CHECK(!*index->checkElement("/a/wings/wing[4]"));
+    BOOST_CHECK(*index->checkAttribute("/a/wings/wing[3]", "uID"));
+    BOOST_CHECK(!*index->checkAttribute("/a/wings/wing[2]", "uID"));
+
+    // elements are only found if the path is unique
+    BOOST_REQUIRE(index->find("/a/wings/wing[2]"));
+    BOOST_CHECK_EQUAL(index->find("/a/wings/wing[2]")->childCount("x"), 1);
+    BOOST_CHECK(!index->find("/a/wings/wing"));
+    BOOST_CHECK(!index->find("/a/wings/wing[2]/@uID"));
+
+    // the runtime answers from the index and falls back to TIXI for unsupported expressions
+    BOOST_CHECK(tixi::TixiCheckElementIndexed(h, "/a/name"));
+    BOOST_CHECK(!tixi::TixiCheckElementIndexed(h, "/a/wings/wing[4]"));
+    BOOST_CHECK(tixi::TixiCheckElementIndexed(h, "/a/wings/wing[last()]"));
+    BOOST_CHECK(tixi::TixiCheckAttributeIndexed(h, "/a/wings/wing[1]", "uID"));
+    BOOST_CHECK(!tixi::TixiCheckAttributeIndexed(h, "/a/wings/wing[2]", "uID"));
+    BOOST_CHECK_EQUAL(tixi::TixiGetNamedChildrenCountIndexed(h, "/a/wings/wing"), 3);
+    BOOST_CHECK(!tixi::TixiTryGetAttribute<std::string>(h, "/a/wings/wing[2]", "uID"));
+    BOOST_CHECK_EQUAL(*tixi::TixiTryGetAttribute<std::string>(h, "/a/wings/wing[3]", "uID"), "w3");
+    BOOST_CHECK(!tixi::TixiTryGetElement<std::string>(h, "/a/description"));
+    BOOST_CHECK_EQUAL(*tixi::TixiTryGetElement<std::string>(h, "/a/name"), "n");
+
+    // the index is not updated, but dropped when the document changes
+    tixi::TixiRemoveElementIndexed(h, "/a/wings/wing[1]");
+    BOOST_CHECK(!tixi::TixiGetElementIndex(h));
+    BOOST_CHECK_EQUAL(tixi::TixiGetNamedChildrenCountIndexed(h, "/a/wings/wing"), 2);
+    BOOST_CHECK(!tixi::TixiCheckAttributeIndexed(h, "/a/wings/wing[1]", "uID"));
+
+    // a rebuilt index sees the change
+    tixi::TixiEnableElementIndex(h, "/a");
+    BOOST_CHECK_EQUAL(*tixi::TixiGetElementIndex(h)->count("/a/wings/wing"), 2);
+    tixi::TixiDisableElementIndex(h);
+    BOOST_CHECK(!tixi::TixiGetElementIndex(h));
+}
+
+BOOST_AUTO_TEST_CASE(tixielementindexdepth) {
+    // deeply nested documents are indexed completely
+    const int depth = 200;
+    std::string xml;
+    for (int i = 0; i < depth; i++)
+        xml += "<e>";
+    for (int i = 0; i < depth; i++)
+        xml += "</e>";
+    const Document doc(xml);
+
+    tixi::TixiEnableElementIndex(doc.handle(), "/e");
+    BOOST_CHECK_EQUAL(tixi::TixiGetElementIndex(doc.handle())->size(), static_cast<std::size_t>(depth));
+    tixi::TixiDisableElementIndex(doc.handle());
+}